@@ -40,116 +40,595 @@
  * mayor también lo hará. Esto nos permite un 'break' directo sin 
  * desperdiciar operaciones.
  *
+ * RANGO EXACTO DE CANDIDATOS (sin recorrer 1..N):
+ * Sea m = min_unused. Los valores usados que ya salieron de la pila son
+ * todos <= lower_bound < m, así que los únicos usados mayores que m son los
+ * que siguen en la pila. Si sacamos de la pila todo lo menor que m y llamamos
+ * U al nuevo tope (o N+1 si la pila queda vacía), entonces:
+ * - Todo valor en [m, U) está libre (ningún elemento de la pila cae ahí).
+ * - Colocar x = m siempre es válido.
+ * - Colocar m < x < U es válido: el límite inferior no cambia y sigue siendo
+ *   menor que m, que queda pendiente.
+ * - Colocar x > U exige sacar U, y el nuevo límite U >= m rompe la poda.
+ * Por lo tanto los candidatos son EXACTAMENTE x = m, m+1, ..., U-1, todos
+ * válidos, sin 'continue' ni 'break'. Y como m sólo cambia cuando usamos
+ * x = m, lo pasamos como parámetro y buscamos el siguiente libre en un
+ * bitset con __builtin_ctzll (una instrucción por cada 64 valores).
+ *
  * COMPLEJIDAD:
- * - Tiempo: O(output). Gracias a la poda perfecta, cada llamada recursiva
- * conduce directamente a una solución válida. El tiempo amortizado es óptimo.
- * - Memoria: O(N). Usamos un vector global como pila y sobreescribimos /
+ * - Tiempo: O(output). Cada llamada recursiva conduce directamente a una
+ * solución válida, cada iteración del bucle es una llamada, y el trabajo
+ * extra por llamada es O(1) amortizado (los pops de la pila se pagan con
+ * sus pushes y la búsqueda en el bitset es O(N / 64)).
+ * - Memoria: O(N). Usamos un solo vector como pila y sobreescribimos /
  * restauramos sus elementos en cada paso. No creamos nuevas estructuras de
  * datos durante la recursión.
+ *
+ * CONTAR, OBTENER EL K-ÉSIMO Y RANKEAR (sin enumerar):
+ * Un preorden es: raíz r, luego el preorden del subárbol izquierdo (valores
+ * 1..r-1) y luego el del derecho (valores r+1..N). Con raíz r hay
+ * Catalan(r-1) * Catalan(N-r) preórdenes, y dentro de ellos el orden
+ * lexicográfico es "primero por el izquierdo, luego por el derecho" (todo el
+ * izquierdo es menor que todo el derecho y tiene largo fijo).
+ * - El total es Catalan(N), que crece como 4^N: usamos enteros grandes.
+ * - Para el k-ésimo (0-indexado) vamos restando bloques de cada raíz
+ *   candidata. Al bajar al subárbol izquierdo llevamos un "multiplicador"
+ *   (cuántos derechos hay por cada izquierdo), así que nunca dividimos:
+ *   O(N^2) multiplicaciones y restas.
+ * - El rank es el camino inverso: sumamos los bloques de las raíces menores.
+ *
+ * MODOS (argumentos de línea de comandos; sin argumentos se comporta igual
+ * que siempre):
+ *   --count          Sólo imprime Catalan(N).
+ *   --kth K          Imprime el preorden de posición K (0-indexada).
+ *   --rank           Lee un preorden después de N e imprime su posición
+ *                    (o -1 si no es un preorden válido).
+ *   --threads T      Enumera en paralelo con T hilos (misma salida, byte a
+ *                    byte, que la versión secuencial).
+ *
+ * Compilando con -DBENCHMARK se mide la generación para n = 14..16
+ * descartando la salida.
  */
 
 #include <iostream>
 #include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#ifdef BENCHMARK
+#include <chrono>
+#endif
 
 using namespace std;
 
 int n;
-vector<int> seq;      // Almacena la secuencia en preorden actual
-vector<bool> used;    // Marca qué números del 1 al N ya están en la secuencia
-vector<int> s;        // Funciona como nuestra pila (stack) de memoria O(N)
-
-// Función recursiva de Backtracking
-// top_idx: índice del tope actual de nuestra pila 's'
-// lower_bound: el límite inferior estricto actual
-void generatePreorders(int top_idx, int lower_bound) {
-    // Caso Base: Hemos colocado N elementos con éxito
-    if (seq.size() == n) {
-        // Imprimimos el resultado (garantizado que es válido)
-        for (int i = 0; i < n; i++) {
-            cout << seq[i] << (i == n - 1 ? "" : " ");
-        }
-        cout << "\n";
-        return;
-    }
 
-    // Buscamos el elemento más pequeño que aún no hemos usado
-    int min_unused = 1;
-    while (min_unused <= n && used[min_unused]) {
-        min_unused++;
+// Búfer de salida: acumulamos el texto y lo escribimos en bloques grandes.
+vector<string> text_of;         // text_of[x] = representación de x en texto
+#ifdef BENCHMARK
+size_t output_bytes = 0;
+#endif
+
+void writeOutput(const string& chunk) {
+#ifdef BENCHMARK
+    output_bytes += chunk.size();
+#else
+    cout.write(chunk.data(), chunk.size());
+#endif
+}
+
+// Estado completo del backtracking. Lo agrupamos en una estructura para que
+// cada hilo pueda tener el suyo (ver generatePreordersParallel).
+struct PreorderGenerator {
+    int n;
+    vector<int> seq;                     // Almacena la secuencia en preorden actual
+    vector<unsigned long long> freeBits; // Bit x encendido = el número x aún no se usa
+    vector<int> s;                       // Funciona como nuestra pila (stack) de memoria O(N)
+    string out_buf;
+    size_t flush_size;                   // Al superar este tamaño se escribe el búfer
+
+    // Prepara las estructuras para un n dado.
+    explicit PreorderGenerator(int size, size_t flush_size = 1 << 16)
+        : n(size), flush_size(flush_size) {
+        // Pre-alojar memoria para garantizar espacio estricto de O(N)
+        seq.reserve(n);
+        s.assign(n + 1, 0);
+        freeBits.assign((n + 1) / 64 + 1, 0);
+        for (int x = 1; x <= n; x++) setFree(x);
     }
 
-    // Variables temporales para simular qué pasa en la pila a medida que
-    // incrementamos nuestra elección de 'x'
-    int current_lower = lower_bound;
-    int current_top = top_idx;
+    void flushOutput() {
+        writeOutput(out_buf);
+        out_buf.clear();
+    }
 
-    // Iteramos intentando colocar el siguiente número del 1 al N.
-    // Iterar en orden ascendente garantiza la salida lexicográfica natural.
-    for (int x = 1; x <= n; x++) {
-        
-        // Simulamos la inserción en el BST. Si 'x' es mayor que el tope,
-        // retrocedemos en el árbol (sacamos de la pila) y actualizamos el límite.
-        // NOTA: No reiniciamos current_top ni current_lower en cada iteración de 'x'.
-        // Como 'x' siempre aumenta, los elementos que debe sacar de la pila 
-        // son los mismos y más, lo que amortiza el costo a O(1).
-        while (current_top >= 0 && x > s[current_top]) {
-            current_lower = s[current_top];
-            current_top--;
+    // Menor número libre que sea >= from (o n+1 si no hay ninguno).
+    int findFree(int from) const {
+        int w = from >> 6;
+        if (w >= (int)freeBits.size()) return n + 1;
+        // Apagamos los bits menores que 'from' en la primera palabra.
+        unsigned long long word = freeBits[w] & (~0ULL << (from & 63));
+        while (word == 0) {
+            if (++w == (int)freeBits.size()) return n + 1;
+            word = freeBits[w];
         }
+        return (w << 6) + __builtin_ctzll(word);
+    }
 
-        if (used[x]) continue;
+    void setUsed(int x) { freeBits[x >> 6] &= ~(1ULL << (x & 63)); }
+    void setFree(int x) { freeBits[x >> 6] |= 1ULL << (x & 63); }
 
-        // Calculamos cuál será el número mínimo disponible si decidimos usar 'x'
-        int next_min_unused = min_unused;
-        if (x == min_unused) {
-            next_min_unused = x + 1;
-            while (next_min_unused <= n && used[next_min_unused]) {
-                next_min_unused++;
+    // Función recursiva de Backtracking
+    // top_idx: índice del tope actual de nuestra pila 's'
+    // min_unused: el número más pequeño que aún no está en la secuencia
+    void generatePreorders(int top_idx, int min_unused) {
+        // Caso Base: Hemos colocado N elementos con éxito
+        if ((int)seq.size() == n) {
+            // Imprimimos el resultado (garantizado que es válido)
+            for (int i = 0; i < n; i++) {
+                if (i > 0) out_buf += ' ';
+                out_buf += text_of[seq[i]];
             }
+            out_buf += '\n';
+            if (out_buf.size() >= flush_size) flushOutput();
+            return;
         }
 
-        // PODA MAESTRA: Si el límite inferior requerido por colocar 'x' es mayor
-        // o igual al elemento más pequeño que aún tenemos pendiente por usar,
-        // es IMPOSIBLE terminar este BST. 
-        // Además, cualquier número mayor que 'x' también exigirá un límite igual
-        // o peor. ¡Podemos cancelar todo el resto de este bucle!
-        if (current_lower >= next_min_unused) {
-            break; 
+        // Sacamos de la pila todo lo menor que min_unused. Lo que quede en el
+        // tope (U) es la cota superior exclusiva de los candidatos.
+        int current_top = top_idx;
+        while (current_top >= 0 && s[current_top] < min_unused) {
+            current_top--;
         }
+        int upper = (current_top >= 0) ? s[current_top] : n + 1;
 
-        // --- Aplicar cambios (Hacer la elección) ---
-        seq.push_back(x);
-        used[x] = true;
-        
         // Guardamos el elemento de la pila que vamos a sobreescribir para
         // mantener la restricción de Memoria O(N) sin clonar vectores.
         int overwritten = s[current_top + 1];
-        s[current_top + 1] = x;
 
-        // Llamada recursiva con el nuevo estado
-        generatePreorders(current_top + 1, current_lower);
+        // Todos los x en [min_unused, upper) son válidos y están libres.
+        // Iterar en orden ascendente garantiza la salida lexicográfica natural.
+        for (int x = min_unused; x < upper; x++) {
+            // --- Aplicar cambios (Hacer la elección) ---
+            seq.push_back(x);
+            setUsed(x);
+            s[current_top + 1] = x;
+
+            // Si usamos el mínimo, el nuevo mínimo es el siguiente bit libre.
+            int next_min_unused = (x == min_unused) ? findFree(x + 1) : min_unused;
 
-        // --- Revertir cambios (Backtracking puro) ---
+            // Llamada recursiva con el nuevo estado
+            generatePreorders(current_top + 1, next_min_unused);
+
+            // --- Revertir cambios (Backtracking puro) ---
+            setFree(x);
+            seq.pop_back();
+        }
         s[current_top + 1] = overwritten;
+    }
+
+    // Coloca un prefijo ya válido simulando la pila. Retorna el tope final.
+    int applyPrefix(const vector<int>& prefix) {
+        int top = -1;
+        for (int x : prefix) {
+            while (top >= 0 && s[top] < x) top--;
+            s[++top] = x;
+            seq.push_back(x);
+            setUsed(x);
+        }
+        return top;
+    }
+
+    // Genera todos los preórdenes que empiezan con 'prefix'.
+    void generateFrom(const vector<int>& prefix) {
+        int top = applyPrefix(prefix);
+        generatePreorders(top, findFree(1));
+    }
+};
+
+// Prepara la tabla de textos para un n dado.
+void initialize(int size) {
+    n = size;
+    text_of.assign(n + 1, "");
+    for (int x = 1; x <= n; x++) {
+        text_of[x] = to_string(x);
+    }
+}
+
+// Entero sin signo de precisión arbitraria (dígitos de 32 bits, el menos
+// significativo primero). Sólo las operaciones que necesitamos.
+struct BigUnsigned {
+    vector<unsigned int> d;
+
+    BigUnsigned(unsigned long long v = 0) {
+        while (v > 0) {
+            d.push_back((unsigned int)v);
+            v >>= 32;
+        }
+    }
+
+    bool isZero() const { return d.empty(); }
+
+    void trim() {
+        while (!d.empty() && d.back() == 0) d.pop_back();
+    }
+
+    static int compare(const BigUnsigned& a, const BigUnsigned& b) {
+        if (a.d.size() != b.d.size()) return a.d.size() < b.d.size() ? -1 : 1;
+        for (int i = (int)a.d.size() - 1; i >= 0; i--) {
+            if (a.d[i] != b.d[i]) return a.d[i] < b.d[i] ? -1 : 1;
+        }
+        return 0;
+    }
+    bool operator<(const BigUnsigned& o) const { return compare(*this, o) < 0; }
+
+    BigUnsigned& operator+=(const BigUnsigned& o) {
+        if (d.size() < o.d.size()) d.resize(o.d.size(), 0);
+        unsigned long long carry = 0;
+        for (size_t i = 0; i < d.size(); i++) {
+            carry += (unsigned long long)d[i] + (i < o.d.size() ? o.d[i] : 0);
+            d[i] = (unsigned int)carry;
+            carry >>= 32;
+        }
+        if (carry) d.push_back((unsigned int)carry);
+        return *this;
+    }
+
+    // Requiere *this >= o.
+    BigUnsigned& operator-=(const BigUnsigned& o) {
+        long long borrow = 0;
+        for (size_t i = 0; i < d.size(); i++) {
+            long long cur = (long long)d[i] - borrow - (i < o.d.size() ? o.d[i] : 0);
+            borrow = cur < 0;
+            d[i] = (unsigned int)(cur + (borrow << 32));
+        }
+        trim();
+        return *this;
+    }
+
+    BigUnsigned operator*(const BigUnsigned& o) const {
+        BigUnsigned r;
+        if (isZero() || o.isZero()) return r;
+        r.d.assign(d.size() + o.d.size(), 0);
+        for (size_t i = 0; i < d.size(); i++) {
+            unsigned long long carry = 0;
+            for (size_t j = 0; j < o.d.size() || carry; j++) {
+                unsigned long long cur = r.d[i + j] + carry +
+                    (j < o.d.size() ? (unsigned long long)d[i] * o.d[j] : 0);
+                r.d[i + j] = (unsigned int)cur;
+                carry = cur >> 32;
+            }
+        }
+        r.trim();
+        return r;
+    }
+
+    void mulSmall(unsigned int m) {
+        unsigned long long carry = 0;
+        for (size_t i = 0; i < d.size(); i++) {
+            carry += (unsigned long long)d[i] * m;
+            d[i] = (unsigned int)carry;
+            carry >>= 32;
+        }
+        if (carry) d.push_back((unsigned int)carry);
+        trim();
+    }
+
+    // Divide entre 'm' y retorna el residuo.
+    unsigned int divSmall(unsigned int m) {
+        unsigned long long rem = 0;
+        for (int i = (int)d.size() - 1; i >= 0; i--) {
+            unsigned long long cur = (rem << 32) | d[i];
+            d[i] = (unsigned int)(cur / m);
+            rem = cur % m;
+        }
+        trim();
+        return (unsigned int)rem;
+    }
+
+    string toString() const {
+        if (isZero()) return "0";
+        BigUnsigned t = *this;
+        string digits;
+        while (!t.isZero()) {
+            unsigned int chunk = t.divSmall(1000000000);
+            for (int k = 0; k < 9; k++) {
+                digits += (char)('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+        while (digits.size() > 1 && digits.back() == '0') digits.pop_back();
+        reverse(digits.begin(), digits.end());
+        return digits;
+    }
+
+    // Retorna false si 'str' no es un número decimal.
+    static bool fromString(const string& str, BigUnsigned& out) {
+        out = BigUnsigned();
+        if (str.empty()) return false;
+        for (char c : str) {
+            if (c < '0' || c > '9') return false;
+            out.mulSmall(10);
+            out += BigUnsigned(c - '0');
+        }
+        return true;
+    }
+};
+
+// catalan[i] = cantidad de BSTs (y de preórdenes) con i llaves, para i = 0..size.
+// Usamos Catalan(i+1) = Catalan(i) * 2(2i+1) / (i+2), que siempre divide exacto.
+vector<BigUnsigned> catalanTable(int size) {
+    vector<BigUnsigned> catalan(size + 1);
+    catalan[0] = BigUnsigned(1);
+    for (int i = 0; i < size; i++) {
+        catalan[i + 1] = catalan[i];
+        catalan[i + 1].mulSmall(2 * (2 * i + 1));
+        catalan[i + 1].divSmall(i + 2);
+    }
+    return catalan;
+}
+
+// Escribe en 'out' el preorden de posición 'k' entre los BST con llaves
+// [lo, hi]. 'mult' es cuántas formas hay de completar lo que viene después
+// de este subárbol por cada preorden suyo; al terminar, 'k' < mult.
+void kthPreorder(int lo, int hi, BigUnsigned& k, const BigUnsigned& mult,
+                 const vector<BigUnsigned>& catalan, vector<int>& out) {
+    if (lo > hi) return;
+    for (int r = lo; r <= hi; r++) {
+        BigUnsigned right_mult = catalan[hi - r] * mult;
+        BigUnsigned block = catalan[r - lo] * right_mult;
+        if (k < block || r == hi) {
+            out.push_back(r);
+            kthPreorder(lo, r - 1, k, right_mult, catalan, out);
+            kthPreorder(r + 1, hi, k, mult, catalan, out);
+            return;
+        }
+        k -= block;
+    }
+}
+
+// Preorden de posición 'k' (0-indexada) entre todos los de 1..size.
+// Retorna false si k >= Catalan(size).
+bool kthPreorder(int size, BigUnsigned k, vector<int>& out) {
+    vector<BigUnsigned> catalan = catalanTable(size);
+    out.clear();
+    if (!(k < catalan[size])) return false;
+    kthPreorder(1, size, k, BigUnsigned(1), catalan, out);
+    return true;
+}
+
+// Suma a 'rank' la posición del preorden p[pos..] con llaves [lo, hi].
+// Retorna false si p no es un preorden válido de esas llaves.
+bool rankPreorder(const vector<int>& p, int& pos, int lo, int hi, const BigUnsigned& mult,
+                  const vector<BigUnsigned>& catalan, BigUnsigned& rank) {
+    if (lo > hi) return true;
+    int r = p[pos++];
+    if (r < lo || r > hi) return false;
+    for (int smaller = lo; smaller < r; smaller++) {
+        rank += catalan[smaller - lo] * catalan[hi - smaller] * mult;
+    }
+    BigUnsigned right_mult = catalan[hi - r] * mult;
+    return rankPreorder(p, pos, lo, r - 1, right_mult, catalan, rank) &&
+           rankPreorder(p, pos, r + 1, hi, mult, catalan, rank);
+}
+
+// Posición (0-indexada) del preorden 'p' de 1..p.size(). False si es inválido.
+bool rankPreorder(const vector<int>& p, BigUnsigned& rank) {
+    int size = p.size();
+    vector<BigUnsigned> catalan = catalanTable(size);
+    rank = BigUnsigned();
+    int pos = 0;
+    return rankPreorder(p, pos, 1, size, BigUnsigned(1), catalan, rank);
+}
+
+// Cantidad de preórdenes que completan 'prefix'. Los números libres quedan
+// separados por los usados en tramos consecutivos, y cada tramo es un
+// subárbol pendiente independiente: el total es el producto de sus Catalan.
+// Usamos double porque sólo sirve para dimensionar tareas.
+double countCompletions(const vector<bool>& used, const vector<double>& catalan) {
+    double total = 1;
+    int run = 0;
+    for (int x = 1; x < (int)used.size(); x++) {
+        if (used[x]) {
+            total *= catalan[run];
+            run = 0;
+        } else {
+            run++;
+        }
+    }
+    return total * catalan[run];
+}
+
+// Parte el árbol de búsqueda en prefijos cuyo número de completaciones no
+// supere 'target'. Las tareas salen en orden lexicográfico.
+void splitTasks(vector<int>& prefix, vector<int>& stack, vector<bool>& used, int size,
+                double target, const vector<double>& catalan, vector<vector<int>>& tasks) {
+    if ((int)prefix.size() == size || countCompletions(used, catalan) <= target) {
+        tasks.push_back(prefix);
+        return;
+    }
+    // Candidatos: [min_unused, U), igual que en generatePreorders.
+    int min_unused = 1;
+    while (used[min_unused]) min_unused++;
+    int top = (int)stack.size() - 1;
+    while (top >= 0 && stack[top] < min_unused) top--;
+    int upper = (top >= 0) ? stack[top] : size + 1;
+
+    vector<int> saved(stack.begin() + top + 1, stack.end());
+    stack.resize(top + 1);
+    for (int x = min_unused; x < upper; x++) {
+        prefix.push_back(x);
+        stack.push_back(x);
+        used[x] = true;
+        splitTasks(prefix, stack, used, size, target, catalan, tasks);
         used[x] = false;
-        seq.pop_back();
+        stack.pop_back();
+        prefix.pop_back();
+    }
+    stack.insert(stack.end(), saved.begin(), saved.end());
+}
+
+// Enumera todos los preórdenes de 1..size con 'threads' hilos.
+// El árbol se divide en tareas por prefijo (raíz y niveles más profundos)
+// de tamaño parecido según los números de Catalan. Los hilos toman la
+// siguiente tarea libre de una cola compartida (así un hilo que termina
+// pronto sigue trabajando), cada tarea escribe en su propio búfer, y el hilo
+// principal escribe los búferes en orden: la salida es idéntica a la secuencial.
+void generatePreordersParallel(int size, int threads) {
+    if (threads < 1) threads = 1;
+    vector<double> catalan(size + 1);
+    catalan[0] = 1;
+    for (int i = 0; i < size; i++) catalan[i + 1] = catalan[i] * 2 * (2 * i + 1) / (i + 2);
+
+    // Muchas más tareas que hilos para repartir bien la carga.
+    double target = max(1.0, catalan[size] / (threads * 64.0));
+    vector<vector<int>> tasks;
+    vector<int> prefix, stack;
+    vector<bool> used(size + 1, false);
+    splitTasks(prefix, stack, used, size, target, catalan, tasks);
+
+    // Ventana de tareas adelantadas, para que la memoria de búferes
+    // pendientes de escribir quede acotada.
+    const size_t WINDOW = threads * 4;
+    vector<string> buffers(tasks.size());
+    vector<char> done(tasks.size(), 0);
+    size_t written = 0;
+    atomic<size_t> next_task(0);
+    mutex m;
+    condition_variable cv;
+
+    auto worker = [&]() {
+        while (true) {
+            size_t t = next_task++;
+            if (t >= tasks.size()) return;
+            {
+                unique_lock<mutex> lock(m);
+                cv.wait(lock, [&] { return t < written + WINDOW; });
+            }
+            PreorderGenerator gen(size, (size_t)-1);
+            gen.generateFrom(tasks[t]);
+            {
+                lock_guard<mutex> lock(m);
+                buffers[t].swap(gen.out_buf);
+                done[t] = 1;
+            }
+            cv.notify_all();
+        }
+    };
+
+    vector<thread> pool;
+    for (int w = 0; w < threads; w++) pool.emplace_back(worker);
+
+    for (size_t t = 0; t < tasks.size(); t++) {
+        string chunk;
+        {
+            unique_lock<mutex> lock(m);
+            cv.wait(lock, [&] { return done[t] != 0; });
+            chunk.swap(buffers[t]);
+        }
+        writeOutput(chunk);
+        {
+            lock_guard<mutex> lock(m);
+            written = t + 1;
+        }
+        cv.notify_all();
     }
+    for (thread& th : pool) th.join();
 }
 
+#ifdef BENCHMARK
 int main() {
+    for (int size = 14; size <= 16; size++) {
+        initialize(size);
+        output_bytes = 0;
+        auto start = chrono::steady_clock::now();
+        PreorderGenerator gen(size);
+        gen.generatePreorders(-1, 1);
+        gen.flushOutput();
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "n = " << size << ": " << secs << " s, " << output_bytes << " bytes ("
+             << (output_bytes / secs / 1e6) << " MB/s)\n";
+
+        int threads = max(1u, thread::hardware_concurrency());
+        output_bytes = 0;
+        start = chrono::steady_clock::now();
+        generatePreordersParallel(size, threads);
+        secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "n = " << size << " (" << threads << " hilos): " << secs << " s, "
+             << output_bytes << " bytes (" << (output_bytes / secs / 1e6) << " MB/s)\n";
+    }
+    return 0;
+}
+#else
+int main(int argc, char* argv[]) {
     // Optimización crítica de I/O, sin esto el problema puede exceder el límite 
     // de 1000ms al imprimir grandes cantidades de datos.
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    if (cin >> n) {
-        // Pre-alojar memoria para garantizar espacio estricto de O(N)
-        seq.reserve(n);
-        used.assign(n + 1, false);
-        s.assign(n, 0);
-        
+    // Lectura de los modos opcionales
+    bool count_only = false, rank_mode = false;
+    int threads = 1;
+    string kth;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--count") == 0) {
+            count_only = true;
+        } else if (strcmp(argv[a], "--kth") == 0 && a + 1 < argc) {
+            kth = argv[++a];
+        } else if (strcmp(argv[a], "--rank") == 0) {
+            rank_mode = true;
+        } else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            threads = atoi(argv[++a]);
+        }
+    }
+
+    if (!(cin >> n)) return 0;
+
+    if (count_only) {
+        cout << catalanTable(n)[n].toString() << "\n";
+        return 0;
+    }
+
+    if (!kth.empty()) {
+        BigUnsigned k;
+        vector<int> p;
+        if (!BigUnsigned::fromString(kth, k) || !kthPreorder(n, k, p)) {
+            cout << "-1\n";
+            return 0;
+        }
+        for (int i = 0; i < n; i++) {
+            cout << p[i] << (i == n - 1 ? "" : " ");
+        }
+        cout << "\n";
+        return 0;
+    }
+
+    if (rank_mode) {
+        vector<int> p(n);
+        for (int i = 0; i < n; i++) cin >> p[i];
+        BigUnsigned rank;
+        cout << (rankPreorder(p, rank) ? rank.toString() : "-1") << "\n";
+        return 0;
+    }
+
+    {
+        initialize(n);
+
+        if (threads > 1) {
+            generatePreordersParallel(n, threads);
+            return 0;
+        }
+
         // Disparador inicial
-        generatePreorders(-1, 0);
+        PreorderGenerator gen(n);
+        gen.generatePreorders(-1, 1);
+        gen.flushOutput();
     }
     return 0;
-}
\ No newline at end of file
+}
+#endif
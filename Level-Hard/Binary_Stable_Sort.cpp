@@ -44,12 +44,48 @@
  * Como dividimos a la mitad, hay O(log N) niveles. Total: O(N log N).
  * - Memoria: O(1) de espacio extra, excluyendo la pila de llamadas del sistema 
  * para la recursión (que es O(log N) y permitida en este tipo de restricciones).
+ *
+ * MODOS ALTERNATIVOS (cuando la memoria extra O(N) está permitida):
+ * Cada rotación mueve structs 'Child' completos, y mover un std::string no es
+ * gratis: O(N log N) movimientos de strings. Agregamos dos variantes que no
+ * tocan los nombres hasta el momento de imprimir:
+ * - "index": el mismo Divide y Vencerás con rotaciones, pero sobre un arreglo
+ *   compacto de índices (4 bytes cada uno) y un arreglo de bits de equipo.
+ * - "buffer": O(N) en dos pasadas. La primera cuenta cuántos 'B' hay (así
+ *   sabemos dónde empiezan los 'R'); la segunda escribe cada índice en su
+ *   posición final con dos cursores. Es estable porque recorremos en orden.
+ * - "parallel": la versión "buffer" repartida entre hilos. Cada hilo cuenta
+ *   los 'B' y 'R' de su bloque contiguo; con sumas de prefijo de esos conteos
+ *   cada bloque sabe exactamente dónde empiezan sus 'B' y sus 'R' en el
+ *   resultado, y todos los hilos escriben a la vez sin pisarse. La
+ *   estabilidad se conserva porque los bloques van en orden y cada hilo
+ *   recorre el suyo en orden.
+ * - "teams": generalización a K equipos (hasta 256, uno por valor del char
+ *   'team'). Es un counting sort estable: histograma de equipos, suma de
+ *   prefijo para saber dónde empieza cada equipo, y una pasada de scatter
+ *   que mueve cada 'Child' a su lugar. Los equipos quedan ordenados por el
+ *   valor de su char ('B' < 'R', así que con dos equipos coincide con los
+ *   demás modos).
+ * El modo por defecto sigue siendo el in-place, que cumple la restricción de
+ * memoria O(1). Se elige con el argumento
+ * --mode inplace|index|buffer|parallel|teams
+ * (y --threads T para el paralelo; por defecto, todos los núcleos).
+ *
+ * Compilando con -DBENCHMARK se comparan los modos sobre 10^8 niños, y el
+ * counting sort de 256 equipos contra 8 particiones binarias (una por bit).
  */
 
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <cstdlib>
 #include <algorithm> // Para std::rotate
+#include <thread>
+#ifdef BENCHMARK
+#include <chrono>
+#include <random>
+#endif
 
 using namespace std;
 
@@ -94,11 +130,201 @@ int stablePartitionInPlace(vector<Child>& arr, int left, int right) {
     return bound1 + (bound2 - mid);
 }
 
+// Misma partición in-place, pero sobre índices. 'red[i]' indica si el niño i
+// es del equipo 'R'. Rotar enteros es mucho más barato que rotar strings.
+int stablePartitionIndices(vector<int>& idx, const vector<char>& red, int left, int right) {
+    if (right - left <= 1) {
+        if (left < right && red[idx[left]]) {
+            return left;
+        }
+        return right;
+    }
+
+    int mid = left + (right - left) / 2;
+    int bound1 = stablePartitionIndices(idx, red, left, mid);
+    int bound2 = stablePartitionIndices(idx, red, mid, right);
+    std::rotate(idx.begin() + bound1, idx.begin() + mid, idx.begin() + bound2);
+    return bound1 + (bound2 - mid);
+}
+
+// Partición estable O(N) con un arreglo auxiliar: retorna el orden final
+// como índices sobre 'red'.
+vector<int> stablePartitionWithBuffer(const vector<char>& red) {
+    int n = red.size();
+
+    // Pasada 1: contar los 'B' para saber dónde empieza el bloque 'R'.
+    int blues = 0;
+    for (int i = 0; i < n; i++) blues += !red[i];
+
+    // Pasada 2: cada índice va directo a su posición final.
+    vector<int> order(n);
+    int next_blue = 0, next_red = blues;
+    for (int i = 0; i < n; i++) {
+        if (red[i]) order[next_red++] = i;
+        else order[next_blue++] = i;
+    }
+    return order;
+}
+
+// Partición estable O(N) con 'threads' hilos. Mismo resultado que
+// stablePartitionWithBuffer.
+vector<int> stablePartitionParallel(const vector<char>& red, int threads) {
+    int n = red.size();
+    if (threads < 1) threads = 1;
+    if (threads > n) threads = max(1, n);
+
+    // Límites del bloque de cada hilo: [begin[t], begin[t + 1]).
+    vector<int> begin(threads + 1);
+    for (int t = 0; t <= threads; t++) begin[t] = (int)((long long)n * t / threads);
+
+    // Pasada 1 (paralela): contar los 'B' de cada bloque.
+    vector<int> blues(threads, 0);
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            int count = 0;
+            for (int i = begin[t]; i < begin[t + 1]; i++) count += !red[i];
+            blues[t] = count;
+        });
+    }
+    for (thread& th : pool) th.join();
+    pool.clear();
+
+    // Suma de prefijo: dónde escribe cada bloque sus 'B' y sus 'R'.
+    int total_blues = 0;
+    for (int t = 0; t < threads; t++) total_blues += blues[t];
+    vector<int> blue_start(threads), red_start(threads);
+    int blues_before = 0;
+    for (int t = 0; t < threads; t++) {
+        blue_start[t] = blues_before;
+        // Los 'R' anteriores son los elementos anteriores que no son 'B'.
+        red_start[t] = total_blues + (begin[t] - blues_before);
+        blues_before += blues[t];
+    }
+
+    // Pasada 2 (paralela): cada hilo escribe su bloque en sus posiciones finales.
+    vector<int> order(n);
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            int next_blue = blue_start[t], next_red = red_start[t];
+            for (int i = begin[t]; i < begin[t + 1]; i++) {
+                if (red[i]) order[next_red++] = i;
+                else order[next_blue++] = i;
+            }
+        });
+    }
+    for (thread& th : pool) th.join();
+    return order;
+}
+
+// Agrupación estable por equipo (counting sort): retorna el orden final como
+// índices. Los equipos quedan en orden creciente de 'key'.
+vector<int> stableGroupByKey(const vector<unsigned char>& key) {
+    int n = key.size();
+
+    // Histograma de equipos.
+    int start[257] = {0};
+    for (int i = 0; i < n; i++) start[key[i] + 1]++;
+
+    // Suma de prefijo: start[k] = posición donde empieza el equipo k.
+    for (int k = 0; k < 256; k++) start[k + 1] += start[k];
+
+    // Scatter: recorrer en orden conserva la estabilidad dentro de cada equipo.
+    vector<int> order(n);
+    for (int i = 0; i < n; i++) order[start[key[i]]++] = i;
+    return order;
+}
+
+// Lo mismo, pero moviendo los registros 'Child' directamente (los strings se
+// mueven, no se copian). Deja a los niños agrupados por equipo en 'arr'.
+void stableGroupChildren(vector<Child>& arr) {
+    int n = arr.size();
+    int start[257] = {0};
+    for (int i = 0; i < n; i++) start[(unsigned char)arr[i].team + 1]++;
+    for (int k = 0; k < 256; k++) start[k + 1] += start[k];
+
+    vector<Child> grouped(n);
+    for (int i = 0; i < n; i++) {
+        grouped[start[(unsigned char)arr[i].team]++] = std::move(arr[i]);
+    }
+    arr.swap(grouped);
+}
+
+#ifdef BENCHMARK
 int main() {
+    const int N = 100000000;
+    mt19937 rng(2024);
+    vector<char> red(N);
+    for (int i = 0; i < N; i++) red[i] = rng() & 1;
+
+    auto timeIt = [](const char* name, auto run) {
+        auto start = chrono::steady_clock::now();
+        vector<int> order = run();
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        unsigned long long checksum = 0;
+        for (int i = 0; i < (int)order.size(); i += 9973) checksum += (unsigned long long)order[i] * i;
+        cout << name << ": " << secs << " s (checksum " << checksum << ")\n";
+    };
+
+    timeIt("index (in-place, rotaciones)", [&]() {
+        vector<int> order(N);
+        for (int i = 0; i < N; i++) order[i] = i;
+        stablePartitionIndices(order, red, 0, N);
+        return order;
+    });
+    timeIt("buffer (1 hilo)", [&]() { return stablePartitionWithBuffer(red); });
+    int max_threads = max(1u, thread::hardware_concurrency());
+    for (int t = 1; t <= max_threads; t *= 2) {
+        string name = "parallel (" + to_string(t) + " hilos)";
+        timeIt(name.c_str(), [&]() { return stablePartitionParallel(red, t); });
+    }
+    red.clear();
+    red.shrink_to_fit();
+
+    // K = 256 equipos: counting sort contra 8 particiones binarias estables
+    // (radix LSD de a un bit, cada pasada con stablePartitionWithBuffer).
+    vector<unsigned char> key(N);
+    for (int i = 0; i < N; i++) key[i] = (unsigned char)rng();
+
+    timeIt("teams (counting sort, 256 equipos)", [&]() { return stableGroupByKey(key); });
+    timeIt("teams (8 particiones binarias)", [&]() {
+        vector<int> order(N);
+        for (int i = 0; i < N; i++) order[i] = i;
+        vector<char> bit(N);
+        for (int b = 0; b < 8; b++) {
+            for (int i = 0; i < N; i++) bit[i] = (key[order[i]] >> b) & 1;
+            vector<int> step = stablePartitionWithBuffer(bit);
+            for (int i = 0; i < N; i++) step[i] = order[step[i]];
+            order.swap(step);
+        }
+        return order;
+    });
+    return 0;
+}
+#else
+int main(int argc, char* argv[]) {
     // Optimización de I/O para programación competitiva
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
+    // Modo de partición: "inplace" (por defecto), "index", "buffer",
+    // "parallel" (usa --threads) o "teams" (agrupa por cualquier equipo).
+    string mode = "inplace";
+    int threads = max(1u, thread::hardware_concurrency());
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--mode") == 0 && a + 1 < argc) {
+            mode = argv[++a];
+        } else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            threads = atoi(argv[++a]);
+        }
+    }
+    if (mode != "inplace" && mode != "index" && mode != "buffer" && mode != "parallel" &&
+        mode != "teams") {
+        cerr << "Modo desconocido: " << mode
+             << " (use inplace, index, buffer, parallel o teams)\n";
+        return 1;
+    }
+
     int n;
     // Leemos la cantidad de niños
     if (cin >> n) {
@@ -109,6 +335,37 @@ int main() {
             cin >> children[i].name >> children[i].team;
         }
 
+        if (mode == "teams") {
+            stableGroupChildren(children);
+            for (int i = 0; i < n; i++) {
+                cout << children[i].name << "\n";
+            }
+            return 0;
+        }
+
+        if (mode == "index" || mode == "buffer" || mode == "parallel") {
+            // Sólo el bit de equipo participa en la partición.
+            vector<char> red(n);
+            for (int i = 0; i < n; i++) red[i] = (children[i].team == 'R');
+
+            vector<int> order;
+            if (mode == "buffer") {
+                order = stablePartitionWithBuffer(red);
+            } else if (mode == "parallel") {
+                order = stablePartitionParallel(red, threads);
+            } else {
+                order.resize(n);
+                for (int i = 0; i < n; i++) order[i] = i;
+                stablePartitionIndices(order, red, 0, n);
+            }
+
+            // Los nombres se leen en el orden final sólo al imprimir.
+            for (int i = 0; i < n; i++) {
+                cout << children[order[i]].name << "\n";
+            }
+            return 0;
+        }
+
         // Ejecutamos la función. Pasamos el rango [0, n)
         stablePartitionInPlace(children, 0, n);
 
@@ -119,4 +376,5 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
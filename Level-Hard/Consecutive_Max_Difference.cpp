@@ -49,91 +49,723 @@
  * COMPLEJIDAD:
  * - Tiempo: O(N) porque iteramos sobre el arreglo un par de veces sin anidaciones.
  * - Memoria: O(N) para almacenar los mínimos y máximos de las cubetas.
+ *
+ * OPTIMIZACIONES PARA ARREGLOS ENORMES:
+ * - Paso 1 con AVX2: comparamos 8 enteros por instrucción (_mm256_min_epi32 /
+ *   _mm256_max_epi32) con dos acumuladores en registros, y reducimos al final.
+ *   Se elige en tiempo de ejecución: si el CPU no tiene AVX2 usamos el bucle
+ *   escalar.
+ * - Paso 3 con varios hilos: cada hilo recorre un bloque del arreglo y llena
+ *   sus PROPIAS cubetas (sin locks ni atómicos). Después combinamos las
+ *   cubetas de todos los hilos con min/max elemento a elemento, también en
+ *   paralelo por rangos de cubetas. Cuesta T veces la memoria de cubetas.
+ * Con --threads T se usa la versión paralela (por defecto, un hilo).
+ *
+ * OTROS TIPOS Y DESBORDAMIENTO:
+ * Con int, max_val - min_val desborda si los valores van de INT_MIN a
+ * INT_MAX. El algoritmo está escrito como plantilla sobre int32, int64,
+ * uint64 y double: las restas de enteros se hacen en el entero sin signo del
+ * mismo ancho (que siempre alcanza) y la respuesta se devuelve en ese tipo.
+ * Con --type int32|int64|uint64|double se elige el tipo de la entrada.
+ *
+ * MODO STREAMING (--file RUTA):
+ * No hace falta tener el arreglo en memoria: leemos el archivo (mismo
+ * formato que la entrada estándar) por bloques, DOS veces. La primera pasada
+ * sólo calcula min, max y N; la segunda llena las cubetas. La memoria es la
+ * de las cubetas (sólo su mínimo y su máximo), no la del arreglo.
+ * Con --buckets M limitamos además la cantidad de cubetas. Con menos de N-1
+ * cubetas el palomar ya no garantiza que la brecha máxima esté ENTRE
+ * cubetas:
+ * - G = mejor brecha entre cubetas no vacías consecutivas.
+ * - Una cubeta con (max - min) > G todavía podría esconder una brecha mayor:
+ *   queda "abierta" (como G >= 0, eso implica que tiene 2 o más elementos).
+ * - Otra pasada por el archivo reparte las M cubetas entre los intervalos
+ *   abiertos (proporcional a su cantidad de elementos) y repite. Si hay más
+ *   de M / 2 intervalos abiertos, los que no caben esperan a otra pasada.
+ * Sólo en este caso contamos (en 32 bits) los elementos de cada cubeta, para
+ * ese reparto. Con M cerca de N / 10 bastan 2 o 3 pasadas; un M mucho menor
+ * ahorra memoria a cambio de más lecturas del archivo.
+ * Con double, si min o max es infinito la respuesta es infinita (el salto
+ * hacia o desde el infinito); no hace falta refinar esos intervalos, que
+ * además nunca se achicarían.
+ *
+ * Compilando con -DBENCHMARK primero se verifican casos de doubles extremos
+ * y luego se comparan las versiones sobre 10^8 enteros.
  */
 
 #include <iostream>
 #include <vector>
 #include <algorithm> // Para std::max y std::min
-#include <climits>   // Para INT_MAX e INT_MIN
+#include <limits>    // Para numeric_limits
+#include <type_traits>
+#include <iomanip>
+#include <cstring>
+#include <string>
+#include <cstdlib>
+#include <thread>
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <cctype>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#ifdef BENCHMARK
+#include <chrono>
+#include <random>
+#endif
 
 using namespace std;
 
-int consecutiveMaxDifference(const vector<int>& nums) {
-    int n = nums.size();
-    
+// Tipo de la respuesta: la brecha entre dos valores de tipo T puede no caber
+// en T (entre INT_MIN e INT_MAX hay casi 2^32), pero sí cabe en el entero sin
+// signo del mismo ancho. Para punto flotante usamos el mismo tipo.
+template <typename T, bool = is_floating_point<T>::value>
+struct GapTraits {
+    typedef typename make_unsigned<T>::type type;
+};
+template <typename T>
+struct GapTraits<T, true> {
+    typedef T type;
+};
+template <typename T>
+using GapType = typename GapTraits<T>::type;
+
+// Mínimo y máximo de a[0..n-1] (n >= 1), versión escalar.
+template <typename T>
+void findMinMaxScalar(const T* a, size_t n, T& min_val, T& max_val) {
+    min_val = a[0];
+    max_val = a[0];
+    for (size_t i = 1; i < n; i++) {
+        min_val = min(min_val, a[i]);
+        max_val = max(max_val, a[i]);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Mínimo y máximo con AVX2: 8 enteros por iteración.
+__attribute__((target("avx2")))
+void findMinMaxAVX2(const int* a, size_t n, int& min_val, int& max_val) {
+    if (n < 8) {
+        findMinMaxScalar(a, n, min_val, max_val);
+        return;
+    }
+    __m256i vmin = _mm256_loadu_si256((const __m256i*)a);
+    __m256i vmax = vmin;
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(a + i));
+        vmin = _mm256_min_epi32(vmin, v);
+        vmax = _mm256_max_epi32(vmax, v);
+    }
+
+    // Reducción horizontal de los 8 carriles.
+    alignas(32) int lanes_min[8], lanes_max[8];
+    _mm256_store_si256((__m256i*)lanes_min, vmin);
+    _mm256_store_si256((__m256i*)lanes_max, vmax);
+    min_val = lanes_min[0];
+    max_val = lanes_max[0];
+    for (int k = 1; k < 8; k++) {
+        min_val = min(min_val, lanes_min[k]);
+        max_val = max(max_val, lanes_max[k]);
+    }
+
+    // Cola que no completa un bloque de 8.
+    for (; i < n; i++) {
+        min_val = min(min_val, a[i]);
+        max_val = max(max_val, a[i]);
+    }
+}
+#endif
+
+// Para tipos sin versión vectorial usamos el bucle escalar.
+template <typename T>
+void findMinMax(const T* a, size_t n, T& min_val, T& max_val) {
+    findMinMaxScalar(a, n, min_val, max_val);
+}
+
+// Para int elegimos la versión más rápida disponible en este CPU.
+void findMinMax(const int* a, size_t n, int& min_val, int& max_val) {
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2) {
+        findMinMaxAVX2(a, n, min_val, max_val);
+        return;
+    }
+#endif
+    findMinMaxScalar(a, n, min_val, max_val);
+}
+
+// Cubeta de x entre k cubetas de [low, hi] con escala k' / (hi - low): el
+// índice se acota a [0, k - 1] (por redondeo) y hi cae siempre en la última.
+template <typename T>
+size_t floatBucket(T x, long double low, long double scale, T hi, size_t k) {
+    if (x == hi) return k - 1;
+    long double q = ((long double)x - low) * scale;
+    if (!(q > 0)) return 0;
+    return (q >= (long double)(k - 1)) ? k - 1 : (size_t)q;
+}
+
+// Con punto flotante, si el mínimo o el máximo es infinito (y min < max) la
+// brecha máxima es infinita: el salto hacia o desde el infinito. Esos casos
+// se resuelven antes de repartir, porque el rango no se puede dividir.
+template <typename T>
+bool infiniteGap(T min_val, T max_val) {
+    if constexpr (is_floating_point<T>::value) {
+        return isinf(min_val) || isinf(max_val);
+    } else {
+        (void)min_val;
+        (void)max_val;
+        return false;
+    }
+}
+
+// Reparto de [min_val, max_val] en cubetas, sin desbordamientos.
+// - Enteros: restamos en el tipo sin signo del mismo ancho. La conversión es
+//   módulo 2^w, así que (U)x - (U)min_val es exacto aunque x - min_val no
+//   quepa en T. Todo se resuelve en tiempo de compilación con 'if constexpr',
+//   así que para int el bucle es el mismo que antes (una resta y una división).
+// - Punto flotante: max_val - min_val puede dar infinito (p. ej. -1e308 y
+//   1e308), y con rangos así de anchos (N - 1) / rango ya es subnormal en
+//   double y pierde precisión. Hacemos la resta y la escala en long double
+//   (exponente de 15 bits: nada desborda ni queda subnormal), usamos N
+//   cubetas de igual ancho y acotamos el índice a [0, N - 1]; max_val va
+//   siempre a la última cubeta.
+template <typename T>
+struct BucketGrid {
+    typedef GapType<T> Gap;
+
+    T min_val, max_val;
+    size_t bucket_count;
+    Gap bucket_size;             // Sólo enteros
+    long double low, scale;      // Sólo punto flotante
+
+    BucketGrid(T min_v, T max_v, size_t n)
+        : min_val(min_v), max_val(max_v), bucket_size(1), low(0), scale(0) {
+        if constexpr (is_floating_point<T>::value) {
+            low = min_v;
+            bucket_count = n;
+            scale = (long double)(n - 1) / ((long double)max_v - low);
+        } else {
+            Gap range = (Gap)max_v - (Gap)min_v;
+            // Nos aseguramos de que el tamaño de la cubeta sea al menos 1.
+            bucket_size = max((Gap)1, (Gap)(range / (Gap)(n - 1)));
+            bucket_count = (size_t)(range / bucket_size) + 1;
+        }
+    }
+
+    // En qué índice de cubeta cae el número x
+    size_t index(T x) const {
+        if constexpr (is_floating_point<T>::value) {
+            return floatBucket(x, low, scale, max_val, bucket_count);
+        } else {
+            return (size_t)(((Gap)x - (Gap)min_val) / bucket_size);
+        }
+    }
+};
+
+// Diferencia b - a (con a <= b) en el tipo de la respuesta.
+template <typename T>
+GapType<T> gapBetween(T a, T b) {
+    return (GapType<T>)b - (GapType<T>)a;
+}
+
+// Paso 4: recorrer las cubetas no vacías. Una cubeta está vacía si su mínimo
+// quedó mayor que su máximo (así una cubeta con un solo valor igual al
+// centinela no se confunde con una vacía).
+template <typename T>
+GapType<T> maxGapFromBuckets(const vector<T>& bucket_min, const vector<T>& bucket_max, T min_val) {
+    GapType<T> max_diff = 0;
+
+    // 'prev_max' guarda el elemento más grande de la última cubeta visitada.
+    // Inicialmente es el min_val del arreglo completo.
+    T prev_max = min_val;
+
+    for (size_t i = 0; i < bucket_min.size(); i++) {
+        // Si la cubeta se quedó con los valores iniciales está vacía. La ignoramos.
+        if (bucket_min[i] > bucket_max[i]) {
+            continue;
+        }
+
+        // Calculamos la diferencia entre el mínimo de esta cubeta y el máximo de la anterior
+        max_diff = max(max_diff, gapBetween(prev_max, bucket_min[i]));
+
+        // Actualizamos prev_max para la siguiente iteración
+        prev_max = bucket_max[i];
+    }
+    return max_diff;
+}
+
+template <typename T>
+GapType<T> consecutiveMaxDifference(const vector<T>& nums) {
+    size_t n = nums.size();
+
     // Casos base
     if (n < 2) return 0;
 
     // 1. Encontrar min_val y max_val en O(N)
-    int min_val = nums[0];
-    int max_val = nums[0];
-    for (int i = 1; i < n; i++) {
-        min_val = min(min_val, nums[i]);
-        max_val = max(max_val, nums[i]);
-    }
+    T min_val, max_val;
+    findMinMax(nums.data(), n, min_val, max_val);
 
     // Si todos los elementos son idénticos
     if (min_val == max_val) return 0;
+    if (infiniteGap(min_val, max_val)) return numeric_limits<GapType<T>>::infinity();
 
     // 2. Calcular tamaño y cantidad de cubetas
-    // Nos aseguramos de que el tamaño de la cubeta sea al menos 1 para evitar división por 0.
-    int bucket_size = max(1, (max_val - min_val) / (n - 1));
-    int bucket_count = ((max_val - min_val) / bucket_size) + 1;
+    BucketGrid<T> grid(min_val, max_val, n);
 
-    // Inicializamos las cubetas con valores extremos
-    vector<int> bucket_min(bucket_count, INT_MAX);
-    vector<int> bucket_max(bucket_count, INT_MIN);
+    // Inicializamos las cubetas con valores extremos (mínimo > máximo = vacía)
+    vector<T> bucket_min(grid.bucket_count, numeric_limits<T>::max());
+    vector<T> bucket_max(grid.bucket_count, numeric_limits<T>::lowest());
 
     // 3. Llenar las cubetas con los valores mínimos y máximos O(N)
-    for (int i = 0; i < n; i++) {
+    for (size_t i = 0; i < n; i++) {
         // En qué índice de cubeta cae el número actual
-        int idx = (nums[i] - min_val) / bucket_size;
-        
+        size_t idx = grid.index(nums[i]);
+
         // Actualizamos el min y max solo para esa cubeta
         bucket_min[idx] = min(bucket_min[idx], nums[i]);
         bucket_max[idx] = max(bucket_max[idx], nums[i]);
     }
 
     // 4. Calcular la diferencia máxima entre cubetas adyacentes no vacías O(N)
-    int max_diff = 0;
-    
-    // 'prev_max' guarda el elemento más grande de la última cubeta visitada.
-    // Inicialmente es el min_val del arreglo completo.
-    int prev_max = min_val; 
+    return maxGapFromBuckets(bucket_min, bucket_max, min_val);
+}
 
-    for (int i = 0; i < bucket_count; i++) {
-        // Si la cubeta se quedó con el valor inicial, significa que está vacía. La ignoramos.
-        if (bucket_min[i] == INT_MAX) {
-            continue;
+// Versión paralela de consecutiveMaxDifference con 'threads' hilos.
+template <typename T>
+GapType<T> consecutiveMaxDifferenceParallel(const vector<T>& nums, int threads) {
+    size_t n = nums.size();
+    if (n < 2) return 0;
+    if (threads < 1) threads = 1;
+    if ((size_t)threads > n) threads = n;
+
+    // Límites del bloque de cada hilo: [begin[t], begin[t + 1]).
+    vector<size_t> begin(threads + 1);
+    for (int t = 0; t <= threads; t++) begin[t] = n * t / threads;
+
+    auto runAll = [threads](auto job) {
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(job, t);
+        for (thread& th : pool) th.join();
+    };
+
+    // 1. Mínimo y máximo por bloque (cada uno con AVX2 si es int) y luego global.
+    vector<T> part_min(threads), part_max(threads);
+    runAll([&](int t) {
+        findMinMax(nums.data() + begin[t], begin[t + 1] - begin[t], part_min[t], part_max[t]);
+    });
+    T min_val = *min_element(part_min.begin(), part_min.end());
+    T max_val = *max_element(part_max.begin(), part_max.end());
+    if (min_val == max_val) return 0;
+    if (infiniteGap(min_val, max_val)) return numeric_limits<GapType<T>>::infinity();
+
+    // 2. Mismas cubetas que la versión secuencial.
+    BucketGrid<T> grid(min_val, max_val, n);
+    size_t bucket_count = grid.bucket_count;
+
+    // 3. Cada hilo llena sus propias cubetas: sin carreras de datos.
+    vector<vector<T>> local_min(threads), local_max(threads);
+    runAll([&](int t) {
+        vector<T>& bmin = local_min[t];
+        vector<T>& bmax = local_max[t];
+        bmin.assign(bucket_count, numeric_limits<T>::max());
+        bmax.assign(bucket_count, numeric_limits<T>::lowest());
+        for (size_t i = begin[t]; i < begin[t + 1]; i++) {
+            size_t idx = grid.index(nums[i]);
+            bmin[idx] = min(bmin[idx], nums[i]);
+            bmax[idx] = max(bmax[idx], nums[i]);
         }
+    });
 
-        // Calculamos la diferencia entre el mínimo de esta cubeta y el máximo de la anterior
-        max_diff = max(max_diff, bucket_min[i] - prev_max);
-        
-        // Actualizamos prev_max para la siguiente iteración
-        prev_max = bucket_max[i];
+    // Combinamos en las cubetas del hilo 0, repartiendo el rango de cubetas.
+    runAll([&](int t) {
+        size_t from = bucket_count * t / threads;
+        size_t to = bucket_count * (t + 1) / threads;
+        for (int other = 1; other < threads; other++) {
+            for (size_t b = from; b < to; b++) {
+                local_min[0][b] = min(local_min[0][b], local_min[other][b]);
+                local_max[0][b] = max(local_max[0][b], local_max[other][b]);
+            }
+        }
+    });
+
+    // 4. Igual que la versión secuencial.
+    return maxGapFromBuckets(local_min[0], local_max[0], min_val);
+}
+
+// Lector de números por bloques desde un archivo, sin cargarlo completo.
+// rewind() permite volver a leerlo desde el principio.
+class NumberStream {
+public:
+    explicit NumberStream(const char* path)
+        : file(fopen(path, "rb")), owns(true), buf(1 << 20), pos(0), len(0) {}
+    // Sobre un FILE* ya abierto (p. ej. stdin), sin cerrarlo ni poder rebobinar.
+    explicit NumberStream(FILE* f) : file(f), owns(false), buf(1 << 20), pos(0), len(0) {}
+    ~NumberStream() {
+        if (file && owns) fclose(file);
     }
 
-    return max_diff;
+    bool ok() const { return file != NULL; }
+
+    void rewind() {
+        fseek(file, 0, SEEK_SET);
+        pos = len = 0;
+    }
+
+    // Lee el siguiente número. Retorna false al llegar al final.
+    template <typename T>
+    bool next(T& value) {
+        int c = peek();
+        while (c != EOF && isspace(c)) {
+            pos++;
+            c = peek();
+        }
+        if (c == EOF) return false;
+
+        if constexpr (is_floating_point<T>::value) {
+            // Los flotantes tienen muchas formas (1e-3, .5, inf...): strtod.
+            // Los infinitos se resuelven antes de repartir en cubetas.
+            char token[64];
+            int size = 0;
+            while (c != EOF && !isspace(c) && size < 63) {
+                token[size++] = (char)c;
+                pos++;
+                c = peek();
+            }
+            token[size] = '\0';
+            value = (T)strtod(token, NULL);
+        } else {
+            // Enteros: acumulamos los dígitos en 64 bits sin signo y aplicamos
+            // el signo al final (módulo 2^64, exacto para todo el rango).
+            bool negative = (c == '-');
+            if (c == '-' || c == '+') {
+                pos++;
+                c = peek();
+            }
+            unsigned long long magnitude = 0;
+            while (c >= '0' && c <= '9') {
+                magnitude = magnitude * 10 + (c - '0');
+                pos++;
+                c = peek();
+            }
+            value = (T)(negative ? 0 - magnitude : magnitude);
+        }
+        return true;
+    }
+
+private:
+    FILE* file;
+    bool owns;
+    vector<char> buf;
+    size_t pos, len;
+
+    inline int peek() {
+        if (pos == len) {
+            len = fread(buf.data(), 1, buf.size(), file);
+            pos = 0;
+            if (len == 0) return EOF;
+        }
+        return (unsigned char)buf[pos];
+    }
+};
+
+// Intervalo de valores [lo, hi] con 'count' elementos (una cota si no los
+// contamos) cuya brecha interna máxima todavía no conocemos.
+template <typename T>
+struct OpenInterval {
+    T lo, hi;
+    size_t count;
+};
+
+// Brecha máxima leyendo el archivo 'path' en streaming, con a lo más
+// 'max_buckets' cubetas (0 = N - 1 cubetas, que resuelve en dos pasadas).
+// Retorna false si no se pudo leer el archivo.
+template <typename T>
+bool consecutiveMaxDifferenceStream(const char* path, size_t max_buckets, GapType<T>& answer) {
+    typedef GapType<T> Gap;
+    NumberStream in(path);
+    if (!in.ok()) return false;
+
+    // Pasada 1: N, min y max. No guardamos los valores.
+    long long declared = 0;
+    if (!in.next(declared)) return false;
+    size_t n = 0;
+    T min_val = T(), max_val = T(), x;
+    while ((long long)n < declared && in.next(x)) {
+        if (n == 0 || x < min_val) min_val = x;
+        if (n == 0 || x > max_val) max_val = x;
+        n++;
+    }
+    answer = 0;
+    if (n < 2 || min_val == max_val) return true;
+    if (infiniteGap(min_val, max_val)) {
+        answer = numeric_limits<GapType<T>>::infinity();
+        return true;
+    }
+    if (max_buckets == 0) max_buckets = n - 1;
+    max_buckets = max(max_buckets, (size_t)2);
+
+    // Con N - 1 cubetas el palomar resuelve todo en una pasada de llenado y
+    // los conteos no se usan: sólo los guardamos si --buckets obliga a refinar.
+    // Si un intervalo se reabre sin conteo (redondeo de punto flotante), N
+    // sirve como cota para repartir las cubetas.
+    bool track_counts = max_buckets < n - 1;
+
+    Gap best = 0;
+    vector<OpenInterval<T>> open(1, OpenInterval<T>{min_val, max_val, n});
+    while (!open.empty()) {
+        // Si hay más intervalos abiertos de los que caben (2 cubetas cada
+        // uno), refinamos sólo los primeros y el resto espera a otra pasada.
+        size_t group = min(open.size(), max_buckets / 2);
+        vector<OpenInterval<T>> waiting(open.begin() + group, open.end());
+        open.resize(group);
+
+        // Repartimos las cubetas entre los intervalos del grupo: 2 para cada
+        // uno y el resto proporcional a su cantidad de elementos. first[i] es
+        // la primera cubeta del intervalo i y k[i] cuántas tiene.
+        size_t open_count = 0;
+        for (const auto& iv : open) open_count += iv.count;
+        size_t spare = max_buckets - 2 * group;
+        vector<size_t> first(open.size() + 1, 0), k(open.size());
+        for (size_t i = 0; i < open.size(); i++) {
+            size_t share = 2 + (size_t)((long double)spare * open[i].count / open_count);
+            // Con count - 1 cubetas el palomar resuelve el intervalo; más no sirve.
+            k[i] = min(share, max((size_t)2, open[i].count - 1));
+            first[i + 1] = first[i] + k[i];
+        }
+        size_t total = first[open.size()];
+
+        // Ancho de cubeta de cada intervalo (enteros) o factor de escala (flotantes).
+        vector<Gap> width(open.size());
+        vector<long double> scale(open.size());
+        for (size_t i = 0; i < open.size(); i++) {
+            if constexpr (is_floating_point<T>::value) {
+                // Igual que BucketGrid: en long double, k cubetas sobre [lo, hi].
+                scale[i] = (long double)k[i] / ((long double)open[i].hi - open[i].lo);
+            } else {
+                // d / (range / k + 1) < k para todo d <= range, sin desbordar.
+                width[i] = ((Gap)open[i].hi - (Gap)open[i].lo) / (Gap)k[i] + 1;
+            }
+        }
+
+        vector<T> bucket_min(total, numeric_limits<T>::max());
+        vector<T> bucket_max(total, numeric_limits<T>::lowest());
+        // Conteo por cubeta, saturado en 32 bits: sólo sirve para repartir.
+        vector<uint32_t> bucket_count(track_counts ? total : 0, 0);
+
+        // Pasada de llenado: cada valor busca su intervalo abierto (ordenados
+        // y disjuntos, así que basta una búsqueda binaria) y su cubeta.
+        in.rewind();
+        in.next(declared);
+        for (size_t read = 0; read < n && in.next(x); read++) {
+            size_t lo = 0, hi = open.size();
+            while (hi - lo > 1) {
+                size_t mid = (lo + hi) / 2;
+                if (open[mid].lo <= x) lo = mid;
+                else hi = mid;
+            }
+            const OpenInterval<T>& iv = open[lo];
+            if (x < iv.lo || x > iv.hi) continue;
+
+            size_t idx;
+            if constexpr (is_floating_point<T>::value) {
+                idx = floatBucket(x, (long double)iv.lo, scale[lo], iv.hi, k[lo]);
+            } else {
+                idx = (size_t)(((Gap)x - (Gap)iv.lo) / width[lo]);
+            }
+            idx += first[lo];
+            bucket_min[idx] = min(bucket_min[idx], x);
+            bucket_max[idx] = max(bucket_max[idx], x);
+            if (track_counts && bucket_count[idx] != UINT32_MAX) bucket_count[idx]++;
+        }
+
+        // Brechas entre cubetas no vacías consecutivas de cada intervalo.
+        for (size_t i = 0; i < open.size(); i++) {
+            T prev_max = open[i].lo;
+            for (size_t b = first[i]; b < first[i + 1]; b++) {
+                if (bucket_min[b] > bucket_max[b]) continue;  // Vacía
+                best = max(best, gapBetween(prev_max, bucket_min[b]));
+                prev_max = bucket_max[b];
+            }
+        }
+
+        // Siguen abiertas las cubetas que podrían esconder una brecha mayor,
+        // y después (por orden de valores) los intervalos que esperaban.
+        vector<OpenInterval<T>> next_open;
+        for (size_t b = 0; b < total; b++) {
+            // Las cubetas vacías (min > max) no pasan el filtro.
+            if (bucket_min[b] <= bucket_max[b] && gapBetween(bucket_min[b], bucket_max[b]) > best) {
+                size_t count = track_counts ? (size_t)bucket_count[b] : n;
+                next_open.push_back(OpenInterval<T>{bucket_min[b], bucket_max[b], count});
+            }
+        }
+        for (const auto& iv : waiting) {
+            if (gapBetween(iv.lo, iv.hi) > best) next_open.push_back(iv);
+        }
+        open.swap(next_open);
+    }
+    answer = best;
+    return true;
+}
+
+#ifdef BENCHMARK
+// Verificación con doubles de magnitudes extremas (rangos cerca de 2e308,
+// subnormales, infinitos) contra ordenar y comparar vecinos.
+bool checkExtremeDoubles() {
+    const double big = numeric_limits<double>::max(), tiny = numeric_limits<double>::denorm_min();
+    const double inf = numeric_limits<double>::infinity();
+    vector<vector<double>> cases = {
+        {-5e307, 5e307},
+        {-big, big},
+        {-big, 0, big},
+        {0, tiny, 2 * tiny, 5 * tiny},
+        {-big, -tiny, tiny, 1e-300, 1e300, big},
+        {1, inf, 3, -2},
+        {-inf, 0, 1},
+    };
+    mt19937 rng(11);
+    for (int c = 0; c < 200; c++) {
+        vector<double> v(2 + rng() % 50);
+        for (double& x : v) {
+            double mantissa = (double)rng() / rng.max() * ((rng() & 1) ? 1 : -1);
+            x = ldexp(mantissa, (int)(rng() % 2100) - 1074);
+        }
+        cases.push_back(v);
+    }
+
+    bool ok = true;
+    for (const auto& v : cases) {
+        vector<double> sorted_v = v;
+        sort(sorted_v.begin(), sorted_v.end());
+        double expected = 0;
+        for (size_t i = 1; i < sorted_v.size(); i++) {
+            expected = max(expected, sorted_v[i] - sorted_v[i - 1]);
+        }
+        double seq = consecutiveMaxDifference(v), par = consecutiveMaxDifferenceParallel(v, 3);
+        if (seq != expected || par != expected) {
+            cout << "FALLA con " << v.size() << " valores: esperado " << expected << ", secuencial "
+                 << seq << ", paralela " << par << "\n";
+            ok = false;
+        }
+    }
+    cout << "verificación de doubles extremos: " << (ok ? "OK" : "FALLA") << "\n";
+    return ok;
 }
 
 int main() {
+    if (!checkExtremeDoubles()) return 1;
+
+    // 10^8 enteros (400 MB); 10^9 no cabe con sus cubetas en una máquina común.
+    const int N = 100000000;
+    mt19937 rng(7);
+    vector<int> nums(N);
+    for (int i = 0; i < N; i++) nums[i] = (int)(rng() >> 1);
+
+    auto seconds = [](auto start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    int mn, mx;
+    auto start = chrono::steady_clock::now();
+    findMinMaxScalar(nums.data(), N, mn, mx);
+    double secs = seconds(start);
+    cout << "min/max escalar: " << secs << " s (" << (N * 4.0 / secs / 1e9) << " GB/s)\n";
+
+    start = chrono::steady_clock::now();
+    findMinMax(nums.data(), N, mn, mx);
+    secs = seconds(start);
+    cout << "min/max despachado (AVX2 si hay): " << secs << " s ("
+         << (N * 4.0 / secs / 1e9) << " GB/s)\n";
+
+    start = chrono::steady_clock::now();
+    int answer = consecutiveMaxDifference(nums);
+    cout << "secuencial: " << seconds(start) << " s (respuesta " << answer << ")\n";
+
+    int max_threads = max(1u, thread::hardware_concurrency());
+    for (int t = 1; t <= max_threads; t *= 2) {
+        start = chrono::steady_clock::now();
+        answer = consecutiveMaxDifferenceParallel(nums, t);
+        cout << "paralela (" << t << " hilos): " << seconds(start) << " s (respuesta "
+             << answer << ")\n";
+    }
+    return 0;
+}
+#else
+// Lee N valores de tipo T, resuelve e imprime la respuesta. Leemos con el
+// mismo NumberStream que el modo streaming, así ambos modos aceptan lo mismo
+// (por ejemplo "inf" en double, que cin no reconoce).
+template <typename T>
+void solve(NumberStream& in, int n, int threads) {
+    vector<T> nums;
+    nums.reserve(n);
+    // Leemos los N elementos del arreglo
+    T x;
+    for (int i = 0; i < n && in.next(x); i++) {
+        nums.push_back(x);
+    }
+
+    // Ejecutamos la función e imprimimos el resultado
+    GapType<T> answer = (threads > 1) ? consecutiveMaxDifferenceParallel(nums, threads)
+                                      : consecutiveMaxDifference(nums);
+    if (is_floating_point<T>::value) cout << setprecision(17);
+    cout << answer << "\n";
+}
+
+// Modo streaming: resuelve leyendo el archivo 'path' e imprime la respuesta.
+template <typename T>
+bool solveStream(const char* path, size_t max_buckets) {
+    GapType<T> answer;
+    if (!consecutiveMaxDifferenceStream<T>(path, max_buckets, answer)) return false;
+    if (is_floating_point<T>::value) cout << setprecision(17);
+    cout << answer << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
     // Optimización de I/O para C++
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int n;
-    // Leemos la cantidad de elementos
-    if (cin >> n) {
-        vector<int> nums(n);
-        // Leemos los N elementos del arreglo
-        for (int i = 0; i < n; i++) {
-            cin >> nums[i];
+    int threads = 1;
+    string type = "int32";
+    const char* path = NULL;
+    size_t max_buckets = 0;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            threads = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--type") == 0 && a + 1 < argc) {
+            type = argv[++a];
+        } else if (strcmp(argv[a], "--file") == 0 && a + 1 < argc) {
+            path = argv[++a];
+        } else if (strcmp(argv[a], "--buckets") == 0 && a + 1 < argc) {
+            max_buckets = strtoull(argv[++a], NULL, 10);
+        }
+    }
+
+    if (path != NULL) {
+        bool ok;
+        if (type == "int64") ok = solveStream<long long>(path, max_buckets);
+        else if (type == "uint64") ok = solveStream<unsigned long long>(path, max_buckets);
+        else if (type == "double") ok = solveStream<double>(path, max_buckets);
+        else ok = solveStream<int>(path, max_buckets);
+        if (!ok) {
+            cerr << "No se pudo leer " << path << "\n";
+            return 1;
         }
+        return 0;
+    }
 
-        // Ejecutamos la función e imprimimos el resultado
-        cout << consecutiveMaxDifference(nums) << "\n";
+    NumberStream in(stdin);
+    int n;
+    // Leemos la cantidad de elementos
+    if (in.next(n)) {
+        if (type == "int64") solve<long long>(in, n, threads);
+        else if (type == "uint64") solve<unsigned long long>(in, n, threads);
+        else if (type == "double") solve<double>(in, n, threads);
+        else solve<int>(in, n, threads);
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
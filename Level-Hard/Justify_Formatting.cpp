@@ -45,11 +45,55 @@
  * la línea. Cada palabra se visita para agruparla y luego para construir el
  * string resultante, lo cual es muy eficiente y cumple holgadamente el límite.
  * - Memoria: O(N * K) para almacenar el texto justificado final resultante.
+ *
+ * MODO ÓPTIMO (--optimal, estilo Knuth-Plass):
+ * El voraz llena cada línea al máximo y puede dejar líneas muy "rotas" más
+ * abajo. Aquí elegimos los cortes que minimizan la suma de los cuadrados de
+ * los espacios sobrantes (slack = K - ancho de la línea) de todas las líneas
+ * salvo la última (que no se justifica, así que no cuesta nada).
+ * - DP: f[j] = costo mínimo de acomodar las primeras j palabras terminando
+ *   una línea justo antes de la palabra j: f[j] = min_i f[i] + w(i, j).
+ * - Con P[] = suma de prefijos de (largo + 1), el ancho de la línea i..j-1 es
+ *   P[j] - P[i] - 1, así que w(i, j) = g(P[j] - P[i]) con g convexa. Si el
+ *   ancho supera K usamos una continuación convexa con pendiente enorme.
+ *   Toda función de ese tipo cumple la desigualdad del cuadrángulo (Monge),
+ *   y eso implica que el mejor 'i' para cada 'j' nunca retrocede.
+ * - Con una cola monótona guardamos, para cada candidato 'i', el tramo de
+ *   'j' donde es el mejor; un candidato nuevo desplaza a los del final y su
+ *   tramo se ubica con búsqueda binaria. Total O(N log N) en vez de O(N^2).
+ *
+ * MODO STREAMING (--stream):
+ * justifyFormatting guarda todas las palabras y todas las líneas. Para textos
+ * arbitrariamente grandes leemos palabra por palabra y sólo guardamos las de
+ * la línea actual (a lo más K letras). Cuando llega una palabra que no cabe,
+ * la línea actual ya es definitiva (no es la última) y la escribimos
+ * justificada directo en un búfer de salida compartido: las palabras con
+ * memcpy y cada hueco de espacios con un solo memset. Memoria constante.
+ *
+ * MODO PÁRRAFOS (--paragraphs [--threads T]):
+ * La entrada es "P K" y luego P párrafos, cada uno como "n palabra1 ... palabran".
+ * Los párrafos son independientes, así que un grupo de hilos los justifica a
+ * la vez: cada hilo toma el siguiente párrafo libre y escribe en el búfer de
+ * ese párrafo. Al final los búferes se escriben en orden, separados por una
+ * línea vacía.
+ *
+ * Compilando con -DBENCHMARK se compara el voraz con el óptimo sobre un
+ * millón de palabras, y se mide el modo párrafos con 1, 2, 4... hilos.
  */
 
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <deque>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#ifdef BENCHMARK
+#include <chrono>
+#include <random>
+#endif
 
 using namespace std;
 
@@ -124,11 +168,355 @@ vector<string> justifyFormatting(int k, const vector<string>& words) {
     return result;
 }
 
+// Arma la línea con las palabras [i, j), con las mismas reglas que
+// justifyFormatting: la última línea y las de una sola palabra van a la
+// izquierda, el resto con justificación completa.
+string formatLine(int k, const vector<string>& words, int i, int j, bool last_line) {
+    string line;
+    line.reserve(k);
+    int num_words_on_line = j - i;
+    if (last_line || num_words_on_line == 1) {
+        for (int w = i; w < j; w++) {
+            line += words[w];
+            if (w < j - 1) line += ' ';
+        }
+        line.append(k - line.size(), ' ');
+        return line;
+    }
+
+    int current_words_length = 0;
+    for (int w = i; w < j; w++) current_words_length += words[w].length();
+    int total_spaces = k - current_words_length;
+    int num_gaps = num_words_on_line - 1;
+    int base_spaces = total_spaces / num_gaps;
+    int extra_spaces = total_spaces % num_gaps;
+    for (int w = i; w < j; w++) {
+        line += words[w];
+        if (w < j - 1) {
+            line.append(base_spaces + (w - i < extra_spaces ? 1 : 0), ' ');
+        }
+    }
+    return line;
+}
+
+// Costos de la DP en 128 bits: la penalización por pasarse de K es enorme y
+// no debe desbordar.
+typedef __int128 Cost;
+
+// Cortes óptimos: retorna las posiciones donde empieza cada línea (más N al
+// final). Supone, como el voraz, que ninguna palabra mide más de K.
+vector<int> optimalBreaks(int k, const vector<string>& words) {
+    int n = words.size();
+    vector<long long> P(n + 1, 0);
+    for (int w = 0; w < n; w++) P[w + 1] = P[w] + (long long)words[w].length() + 1;
+
+    // Cualquier solución sin líneas largas cuesta menos que n * K^2, así que
+    // con esta pendiente una línea larga nunca conviene.
+    const Cost overflow_slope = (Cost)(n + 1) * (Cost)(k + 1) * (Cost)(k + 1);
+    auto w = [&](int i, int j) -> Cost {
+        long long width = P[j] - P[i] - 1;
+        if (width <= k) return (Cost)(k - width) * (k - width);
+        return overflow_slope * (width - k);  // Continuación convexa
+    };
+
+    vector<Cost> f(n + 1, 0);
+    vector<int> from(n + 1, 0);
+
+    // Cola monótona: (candidato, primer j donde es el mejor).
+    deque<pair<int, int>> queue;
+    queue.push_back({0, 1});
+    auto beats = [&](int newer, int older, int j) {
+        return f[newer] + w(newer, j) <= f[older] + w(older, j);
+    };
+
+    for (int j = 1; j <= n; j++) {
+        while (queue.size() > 1 && queue[1].second <= j) queue.pop_front();
+        int best = queue.front().first;
+        f[j] = f[best] + w(best, j);
+        from[j] = best;
+        if (j == n) break;
+
+        // 'j' como candidato para los j' > j.
+        while (!queue.empty() && queue.back().second > j &&
+               beats(j, queue.back().first, queue.back().second)) {
+            queue.pop_back();
+        }
+        if (queue.empty()) {
+            queue.push_back({j, j + 1});
+            continue;
+        }
+        // Primer j' donde 'j' le gana al último candidato (si existe).
+        int lo = max(queue.back().second, j + 1), hi = n + 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (beats(j, queue.back().first, mid)) hi = mid;
+            else lo = mid + 1;
+        }
+        if (lo <= n) queue.push_back({j, lo});
+    }
+
+    // La última línea no cuesta nada: elegimos el mejor inicio factible.
+    int last_start = n - 1;
+    for (int i = n - 1; i >= 0 && P[n] - P[i] - 1 <= k; i--) {
+        if (f[i] <= f[last_start]) last_start = i;
+    }
+
+    vector<int> starts;
+    starts.push_back(n);
+    for (int i = last_start; i > 0; i = from[i]) starts.push_back(i);
+    starts.push_back(0);
+    return vector<int>(starts.rbegin(), starts.rend());
+}
+
+// Justificación con los cortes óptimos.
+vector<string> justifyOptimal(int k, const vector<string>& words) {
+    vector<string> result;
+    if (words.empty()) return result;
+    vector<int> starts = optimalBreaks(k, words);
+    for (size_t line = 0; line + 1 < starts.size(); line++) {
+        result.push_back(formatLine(k, words, starts[line], starts[line + 1],
+                                    line + 2 == starts.size()));
+    }
+    return result;
+}
+
+// Búfer de salida: las líneas se escriben directo aquí y se vuelcan en
+// bloques grandes a 'os'.
+class LineWriter {
+public:
+    explicit LineWriter(ostream& os, size_t capacity = 1 << 16)
+        : os(os), buf(capacity), used(0) {}
+    ~LineWriter() { flush(); }
+
+    // Reserva 'size' bytes contiguos y retorna dónde escribirlos.
+    char* reserve(size_t size) {
+        if (used + size > buf.size()) {
+            flush();
+            if (size > buf.size()) buf.resize(size);
+        }
+        char* at = buf.data() + used;
+        used += size;
+        return at;
+    }
+
+    void flush() {
+        os.write(buf.data(), used);
+        used = 0;
+    }
+
+private:
+    ostream& os;
+    vector<char> buf;
+    size_t used;
+};
+
+// Escritor que agrega las líneas al final de un string (un búfer por párrafo).
+struct StringWriter {
+    string& s;
+    char* reserve(size_t size) {
+        size_t old = s.size();
+        s.resize(old + size);
+        return &s[old];
+    }
+};
+
+// Palabras de la línea en construcción: letras pegadas en 'text' y dónde
+// empieza cada una en 'starts'. Nunca guarda más de K letras.
+struct PendingLine {
+    string text;
+    vector<int> starts;
+
+    int count() const { return starts.size(); }
+    int letters() const { return text.size(); }
+    void clear() {
+        text.clear();
+        starts.clear();
+    }
+    void add(const string& word) {
+        starts.push_back(text.size());
+        text += word;
+    }
+};
+
+// Escribe la línea pendiente en 'out' con las mismas reglas que
+// justifyFormatting, sin construir ningún std::string intermedio.
+template <typename Writer>
+void emitLine(int k, const PendingLine& line, bool last_line, Writer& out) {
+    char* at = out.reserve(k + 1);
+    int words = line.count();
+    int total_spaces = k - line.letters();
+    int num_gaps = words - 1;
+    bool left_aligned = last_line || words == 1;
+    int base_spaces = left_aligned ? 1 : total_spaces / num_gaps;
+    int extra_spaces = left_aligned ? 0 : total_spaces % num_gaps;
+
+    for (int w = 0; w < words; w++) {
+        int begin = line.starts[w];
+        int end = (w + 1 < words) ? line.starts[w + 1] : line.letters();
+        memcpy(at, line.text.data() + begin, end - begin);
+        at += end - begin;
+        if (w < num_gaps) {
+            int spaces = base_spaces + (w < extra_spaces ? 1 : 0);
+            memset(at, ' ', spaces);
+            at += spaces;
+            total_spaces -= spaces;
+        }
+    }
+    // Relleno a la derecha (sólo queda algo si la línea va a la izquierda).
+    memset(at, ' ', total_spaces);
+    at += total_spaces;
+    *at = '\n';
+}
+
+// Lee 'n' palabras de 'in' y escribe el texto justificado en 'os' sin
+// guardar más de una línea de palabras.
+void justifyStreaming(int k, long long n, istream& in, ostream& os) {
+    LineWriter out(os);
+    PendingLine line;
+    string word;
+    for (long long read = 0; read < n && in >> word; read++) {
+        // ¿Cabe la palabra con un espacio mínimo por hueco?
+        if (line.count() > 0 &&
+            line.letters() + (int)word.size() + line.count() > k) {
+            emitLine(k, line, false, out);
+            line.clear();
+        }
+        line.add(word);
+    }
+    if (line.count() > 0) emitLine(k, line, true, out);
+}
+
+// Justifica un párrafo completo y agrega sus líneas a 'out'.
+void justifyParagraph(int k, const vector<string>& words, string& out) {
+    StringWriter writer{out};
+    PendingLine line;
+    for (const string& word : words) {
+        if (line.count() > 0 &&
+            line.letters() + (int)word.size() + line.count() > k) {
+            emitLine(k, line, false, writer);
+            line.clear();
+        }
+        line.add(word);
+    }
+    if (line.count() > 0) emitLine(k, line, true, writer);
+}
+
+// Justifica todos los párrafos con 'threads' hilos. Retorna un búfer por
+// párrafo, en el mismo orden de la entrada.
+vector<string> justifyParagraphsParallel(int k, const vector<vector<string>>& paragraphs,
+                                         int threads) {
+    vector<string> buffers(paragraphs.size());
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t p = next++; p < paragraphs.size(); p = next++) {
+            justifyParagraph(k, paragraphs[p], buffers[p]);
+        }
+    };
+    if (threads < 1) threads = 1;
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();  // El hilo principal también trabaja
+    for (thread& th : pool) th.join();
+    return buffers;
+}
+
+#ifdef BENCHMARK
+// Suma de los cuadrados de los espacios sobrantes (sin contar la última
+// línea). Las palabras no tienen espacios, así que cada tramo de letras de
+// una línea es una palabra.
+long long raggedness(const vector<string>& lines, int k) {
+    long long total = 0;
+    for (size_t l = 0; l + 1 < lines.size(); l++) {
+        long long letters = 0, count = 0;
+        for (size_t c = 0; c < lines[l].size(); c++) {
+            if (lines[l][c] == ' ') continue;
+            letters++;
+            if (c == 0 || lines[l][c - 1] == ' ') count++;
+        }
+        long long slack = k - (letters + count - 1);
+        total += slack * slack;
+    }
+    return total;
+}
+
 int main() {
+    const int N = 1000000, K = 80;
+    mt19937 rng(99);
+    vector<string> words(N);
+    for (string& word : words) word.assign(1 + rng() % 12, 'a' + rng() % 26);
+
+    auto start = chrono::steady_clock::now();
+    vector<string> greedy = justifyFormatting(K, words);
+    double greedy_secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    vector<string> optimal = justifyOptimal(K, words);
+    double optimal_secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Voraz:  " << greedy_secs << " s, " << greedy.size() << " líneas, costo "
+         << raggedness(greedy, K) << "\n";
+    cout << "Óptimo: " << optimal_secs << " s, " << optimal.size() << " líneas, costo "
+         << raggedness(optimal, K) << "\n";
+
+    // 20000 párrafos de 50 a 150 palabras.
+    vector<vector<string>> paragraphs(20000);
+    size_t next_word = 0;
+    for (auto& paragraph : paragraphs) {
+        int size = 50 + rng() % 101;
+        for (int w = 0; w < size; w++) paragraph.push_back(words[next_word++ % N]);
+    }
+    int max_threads = max(1u, thread::hardware_concurrency());
+    for (int t = 1; t <= max_threads; t *= 2) {
+        start = chrono::steady_clock::now();
+        vector<string> buffers = justifyParagraphsParallel(K, paragraphs, t);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        size_t bytes = 0;
+        for (const string& b : buffers) bytes += b.size();
+        cout << "Párrafos (" << t << " hilos): " << secs << " s, " << bytes << " bytes\n";
+    }
+    return 0;
+}
+#else
+int main(int argc, char* argv[]) {
     // Optimización de I/O para programación competitiva
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
+    bool optimal = false, streaming = false, by_paragraphs = false;
+    int threads = max(1u, thread::hardware_concurrency());
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--optimal") == 0) optimal = true;
+        else if (strcmp(argv[a], "--stream") == 0) streaming = true;
+        else if (strcmp(argv[a], "--paragraphs") == 0) by_paragraphs = true;
+        else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) threads = atoi(argv[++a]);
+    }
+
+    if (by_paragraphs) {
+        int p, k;
+        if (!(cin >> p >> k)) return 0;
+        vector<vector<string>> paragraphs(p);
+        for (auto& paragraph : paragraphs) {
+            int n;
+            cin >> n;
+            paragraph.resize(n);
+            for (string& word : paragraph) cin >> word;
+        }
+        vector<string> buffers = justifyParagraphsParallel(k, paragraphs, threads);
+        for (size_t i = 0; i < buffers.size(); i++) {
+            if (i > 0) cout << "\n";
+            cout.write(buffers[i].data(), buffers[i].size());
+            string().swap(buffers[i]);
+        }
+        return 0;
+    }
+
+    if (streaming) {
+        long long n;
+        int k;
+        if (cin >> n >> k) justifyStreaming(k, n, cin, cout);
+        return 0;
+    }
+
     int n, k;
     // Leemos N (cantidad de palabras) y K (límite de línea)
     if (cin >> n >> k) {
@@ -140,7 +528,8 @@ int main() {
         }
 
         // Ejecutamos la función de justificación
-        vector<string> justified_text = justifyFormatting(k, words);
+        vector<string> justified_text = optimal ? justifyOptimal(k, words)
+                                                : justifyFormatting(k, words);
         
         // Imprimimos el resultado línea por línea
         for (const string& line : justified_text) {
@@ -149,4 +538,5 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
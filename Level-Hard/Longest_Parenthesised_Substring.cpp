@@ -41,11 +41,72 @@
  * COMPLEJIDAD:
  * - Tiempo: O(N) porque recorremos la cadena 2 veces (2N sigue siendo lineal).
  * - Memoria: O(1) variables simples, sin estructuras de datos complejas.
+ *
+ * VERSIÓN PARALELA POR BLOQUES (--threads T):
+ * Sea B[i] el balance del prefijo de largo i ('(' suma 1, ')' resta 1).
+ * - El escaneo de izquierda a derecha reinicia cuando B baja de su mínimo
+ *   histórico, así que su "base" es siempre el mínimo de B[0..i], y detecta
+ *   una subcadena cada vez que B[i] vuelve a ser igual a ese mínimo (largo =
+ *   i - primera posición donde se alcanzó).
+ * - El de derecha a izquierda es el espejo: la base es el mínimo de B[i..n]
+ *   y el largo es (última posición donde se alcanzó) - i.
+ * Entonces a cada bloque sólo le hace falta saber con qué base entra:
+ * 1. En paralelo, cada bloque calcula su resumen: balance neto, balance
+ *    mínimo y la primera y última posición donde lo alcanza.
+ * 2. Combinamos los resúmenes (una operación asociativa, O(bloques)) para
+ *    obtener el balance inicial de cada bloque y la base de entrada en cada
+ *    dirección.
+ * 3. En paralelo, cada bloque hace ambos escaneos con su base de entrada y
+ *    reporta su mejor largo. La respuesta es el máximo.
+ * ¿Por qué dos pasadas y no una sola con resúmenes que ya traigan el mejor
+ * tramo interno y los tramos de borde? Porque los tramos que cruzan un borde
+ * dependen de con qué base entra el bloque: para combinarlos de forma exacta
+ * cada resumen tendría que guardar, por cada profundidad que alcanza, dónde
+ * termina el tramo (un perfil de tamaño O(profundidad), hasta O(N) con
+ * cadenas como "((((..."). Con bases de entrada el resumen es de tamaño fijo
+ * y la memoria extra es O(bloques). Para que la segunda pasada no vuelva a
+ * leer la cadena desde memoria dos veces, los bloques son de 256 KB y cada
+ * hilo hace ambos escaneos de un bloque seguidos, mientras está en caché: la
+ * cadena se lee de memoria dos veces en total.
+ * Usamos long long porque con cadenas de gigabytes las posiciones no caben
+ * en int.
+ *
+ * VERSIÓN VECTORIZADA (--simd):
+ * El bucle original decide carácter por carácter si suma o resta, y esos
+ * saltos son difíciles de predecir en cadenas aleatorias. Con AVX2 leemos 32
+ * caracteres a la vez, los convertimos en ±1 y calculamos dentro del registro
+ * las sumas de prefijo, la base (mínimo de prefijo) en cada posición, dónde
+ * se reinicia el conteo y dónde abiertos == cerrados. Del bloque sólo salen
+ * el mejor largo y el estado (balance, base, posición de la base) con el que
+ * sigue el siguiente bloque. Sin AVX2 se usa el mismo escaneo escalar.
+ *
+ * CONSULTAS POR VENTANAS (--queries):
+ * Para muchas ventanas s[l..r] de la misma cadena construimos una sola vez
+ * un árbol de segmentos sobre los balances de prefijo (mínimo con su primera
+ * y última posición) y sobre el largo de la subcadena válida más larga que
+ * empieza / termina en cada posición. Cada ventana se responde en O(log n).
+ * Entrada: la cadena, Q, y luego Q pares "l r" (0-indexados, inclusivos).
+ * Si algún par no cumple 0 <= l <= r < N el programa termina con un error.
+ *
+ * Compilando con -DBENCHMARK se mide el rendimiento (GB/s) de cada versión
+ * y el de las consultas por ventanas.
  */
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <thread>
+#include <climits>
 #include <algorithm> // Para std::max
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#ifdef BENCHMARK
+#include <chrono>
+#include <random>
+#endif
 
 using namespace std;
 
@@ -122,17 +183,550 @@ int longestParenthesisedSubstring(string s) {
     return max_len;
 }
 
+// Resumen de un bloque de la cadena: con estos datos se puede continuar el
+// escaneo sin volver a leer el bloque.
+struct ChunkSummary {
+    long long net;       // Balance al final del bloque (relativo a su inicio)
+    long long min_bal;   // Balance mínimo, contando el 0 del inicio
+    long long first_min; // Primera posición (absoluta) con ese mínimo
+    long long last_min;  // Última posición (absoluta) con ese mínimo
+};
+
+ChunkSummary summarize(const string& s, long long begin, long long end) {
+    ChunkSummary sum = {0, 0, begin, begin};
+    long long bal = 0;
+    for (long long i = begin; i < end; i++) {
+        bal += (s[i] == '(') ? 1 : -1;
+        if (bal < sum.min_bal) {
+            sum.min_bal = bal;
+            sum.first_min = sum.last_min = i + 1;
+        } else if (bal == sum.min_bal) {
+            sum.last_min = i + 1;
+        }
+    }
+    sum.net = bal;
+    return sum;
+}
+
+long long longestParenthesisedSubstringParallel(const string& s, int threads) {
+    long long n = s.size();
+    if (threads < 1) threads = 1;
+
+    // Bloques de 256 KB: la pasada 3 lee cada uno en ambas direcciones
+    // mientras sigue en caché, así que de memoria sólo se lee dos veces.
+    const long long BLOCK = 1 << 18;
+    long long blocks = max(1LL, (n + BLOCK - 1) / BLOCK);
+    if (threads > blocks) threads = (int)blocks;
+
+    vector<long long> begin(blocks + 1);
+    for (long long b = 0; b <= blocks; b++) begin[b] = min(n, b * BLOCK);
+
+    // Cada hilo se encarga de un tramo contiguo de bloques.
+    auto runAll = [threads, blocks](auto job) {
+        auto work = [&](int t) {
+            for (long long b = blocks * t / threads; b < blocks * (t + 1) / threads; b++) job(b);
+        };
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(work, t);
+        work(0);  // El hilo principal también trabaja
+        for (thread& th : pool) th.join();
+    };
+
+    // 1. Resumen de cada bloque.
+    vector<ChunkSummary> sums(blocks);
+    runAll([&](long long b) { sums[b] = summarize(s, begin[b], begin[b + 1]); });
+
+    // 2. Combinación: balance inicial de cada bloque y bases de entrada.
+    //    De izquierda a derecha: mínimo de B[0..inicio] y su PRIMERA posición.
+    //    De derecha a izquierda: mínimo de B[fin..n] y su ÚLTIMA posición.
+    vector<long long> start_bal(blocks + 1, 0);
+    for (long long b = 0; b < blocks; b++) start_bal[b + 1] = start_bal[b] + sums[b].net;
+
+    vector<long long> left_min(blocks), left_pos(blocks);
+    long long cur_min = 0, cur_pos = 0;
+    for (long long b = 0; b < blocks; b++) {
+        left_min[b] = cur_min;
+        left_pos[b] = cur_pos;
+        if (start_bal[b] + sums[b].min_bal < cur_min) {
+            cur_min = start_bal[b] + sums[b].min_bal;
+            cur_pos = sums[b].first_min;
+        }
+    }
+
+    vector<long long> right_min(blocks), right_pos(blocks);
+    cur_min = start_bal[blocks];
+    cur_pos = n;
+    for (long long b = blocks - 1; b >= 0; b--) {
+        right_min[b] = cur_min;
+        right_pos[b] = cur_pos;
+        if (start_bal[b] + sums[b].min_bal < cur_min) {
+            cur_min = start_bal[b] + sums[b].min_bal;
+            cur_pos = sums[b].last_min;
+        }
+    }
+
+    // 3. Ambos escaneos dentro de cada bloque, con su base de entrada.
+    vector<long long> best(blocks, 0);
+    runAll([&](long long b) {
+        long long local_best = 0;
+
+        // Izquierda a derecha: la base es el mínimo del prefijo.
+        long long bal = start_bal[b], base = left_min[b], base_pos = left_pos[b];
+        for (long long i = begin[b]; i < begin[b + 1]; i++) {
+            bal += (s[i] == '(') ? 1 : -1;
+            if (bal < base) {
+                base = bal;
+                base_pos = i + 1;
+            } else if (bal == base) {
+                local_best = max(local_best, i + 1 - base_pos);
+            }
+        }
+
+        // Derecha a izquierda: la base es el mínimo del sufijo.
+        bal = start_bal[b + 1];
+        base = right_min[b];
+        base_pos = right_pos[b];
+        for (long long i = begin[b + 1] - 1; i >= begin[b]; i--) {
+            bal -= (s[i] == '(') ? 1 : -1;  // Balance en la posición i
+            if (bal < base) {
+                base = bal;
+                base_pos = i;
+            } else if (bal == base) {
+                local_best = max(local_best, base_pos - i);
+            }
+        }
+        best[b] = local_best;
+    });
+
+    long long max_len = *max_element(best.begin(), best.end());
+    return max_len == 0 ? -1 : max_len;
+}
+
+// Estado de un escaneo en términos de balances: equivale a los contadores
+// de la versión original (abiertos - cerrados = bal - base, y cuando son
+// iguales la subcadena mide pos - base_pos = 2 * cerrados).
+struct ScanState {
+    long long bal;      // Balance actual
+    long long base;     // Balance mínimo visto (donde se reinició el conteo)
+    long long base_pos; // Primera posición donde se alcanzó ese mínimo
+    long long best;     // Mejor largo encontrado
+};
+
+// Un paso del escaneo: 'delta' es +1 o -1 y 'pos' la posición tras leerlo.
+inline void scanStep(ScanState& st, int delta, long long pos) {
+    st.bal += delta;
+    if (st.bal < st.base) {
+        st.base = st.bal;
+        st.base_pos = pos;
+    } else if (st.bal == st.base) {
+        st.best = max(st.best, pos - st.base_pos);
+    }
+}
+
+// Escaneo escalar en una dirección. De derecha a izquierda es el mismo
+// escaneo sobre la cadena invertida con los papeles de '(' y ')' cambiados.
+long long scanDirectionScalar(const char* s, long long n, bool reverse) {
+    ScanState st = {0, 0, 0, 0};
+    char open = reverse ? ')' : '(';
+    for (long long i = 0; i < n; i++) {
+        char c = reverse ? s[n - 1 - i] : s[i];
+        scanStep(st, c == open ? 1 : -1, i + 1);
+    }
+    return st.best;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Sumas de prefijo de 32 bytes (con signo): primero dentro de cada mitad de
+// 128 bits y luego sumamos el total de la mitad baja a la alta.
+__attribute__((target("avx2")))
+static inline __m256i prefixSum32(__m256i x) {
+    x = _mm256_add_epi8(x, _mm256_slli_si256(x, 1));
+    x = _mm256_add_epi8(x, _mm256_slli_si256(x, 2));
+    x = _mm256_add_epi8(x, _mm256_slli_si256(x, 4));
+    x = _mm256_add_epi8(x, _mm256_slli_si256(x, 8));
+    __m256i carry = _mm256_shuffle_epi8(x, _mm256_set1_epi8(15));
+    carry = _mm256_permute2x128_si256(carry, carry, 0x08);  // [0, total baja]
+    return _mm256_add_epi8(x, carry);
+}
+
+// Mínimos de prefijo de 32 bytes, acotados arriba por 0 (el 0 que entra por
+// los desplazamientos hace de "sin valor" porque siempre tomamos min con 0).
+__attribute__((target("avx2")))
+static inline __m256i prefixMinClamped32(__m256i x) {
+    x = _mm256_min_epi8(x, _mm256_slli_si256(x, 1));
+    x = _mm256_min_epi8(x, _mm256_slli_si256(x, 2));
+    x = _mm256_min_epi8(x, _mm256_slli_si256(x, 4));
+    x = _mm256_min_epi8(x, _mm256_slli_si256(x, 8));
+    __m256i carry = _mm256_shuffle_epi8(x, _mm256_set1_epi8(15));
+    carry = _mm256_permute2x128_si256(carry, carry, 0x08);
+    return _mm256_min_epi8(_mm256_min_epi8(x, carry), _mm256_setzero_si256());
+}
+
+// Máximos de prefijo de 32 bytes sin signo (el 0 es neutro).
+__attribute__((target("avx2")))
+static inline __m256i prefixMax32(__m256i x) {
+    x = _mm256_max_epu8(x, _mm256_slli_si256(x, 1));
+    x = _mm256_max_epu8(x, _mm256_slli_si256(x, 2));
+    x = _mm256_max_epu8(x, _mm256_slli_si256(x, 4));
+    x = _mm256_max_epu8(x, _mm256_slli_si256(x, 8));
+    __m256i carry = _mm256_shuffle_epi8(x, _mm256_set1_epi8(15));
+    carry = _mm256_permute2x128_si256(carry, carry, 0x08);
+    return _mm256_max_epu8(x, carry);
+}
+
+// Desplaza los 32 bytes una posición hacia arriba (entra un 0 en el byte 0).
+__attribute__((target("avx2")))
+static inline __m256i shiftUpOne32(__m256i x) {
+    return _mm256_alignr_epi8(x, _mm256_permute2x128_si256(x, x, 0x08), 15);
+}
+
+// Máximo horizontal de 32 bytes sin signo.
+__attribute__((target("avx2")))
+static inline int horizontalMax32(__m256i x) {
+    __m128i m = _mm_max_epu8(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 8));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 4));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 2));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 1));
+    return _mm_cvtsi128_si32(m) & 0xFF;
+}
+
+// Escaneo con AVX2: 32 caracteres por iteración y sin saltos por carácter.
+// Con st.bal, st.base y el bloque de ±1 calculamos en registros:
+// - Y[i]  = balance tras el carácter i menos la base de entrada.
+// - PM[i] = min(0, Y[0..i]): la base en cada posición (relativa).
+// - Reinicio en i si PM[i] < PM[i-1]; LR[i] = última posición de reinicio
+//   (1..32) hasta i, o 0 si todavía vale la base de entrada.
+// - Coincidencia en i si Y[i] == PM[i]: su largo es (i + 1) - LR[i], o bien
+//   (inicio + i + 1) - st.base_pos si LR[i] == 0.
+// Si la base está más de 32 por debajo del balance, ningún carácter del
+// bloque puede alcanzarla y sólo actualizamos el balance.
+__attribute__((target("avx2")))
+long long scanDirectionAVX2(const char* s, long long n, bool reverse) {
+    ScanState st = {0, 0, 0, 0};
+    const __m256i open = _mm256_set1_epi8(reverse ? ')' : '(');
+    const __m256i plus = _mm256_set1_epi8(1), minus = _mm256_set1_epi8(-1);
+    const __m256i idx = _mm256_setr_epi8(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+                                         17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+                                         31, 32);
+    const __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                         15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i zero = _mm256_setzero_si256();
+
+    long long o = 0;
+    for (; o + 32 <= n; o += 32) {
+        __m256i c;
+        if (reverse) {
+            c = _mm256_loadu_si256((const __m256i*)(s + n - o - 32));
+            c = _mm256_shuffle_epi8(c, rev);
+            c = _mm256_permute2x128_si256(c, c, 0x01);
+        } else {
+            c = _mm256_loadu_si256((const __m256i*)(s + o));
+        }
+        __m256i is_open = _mm256_cmpeq_epi8(c, open);
+
+        long long rel = st.base - st.bal;  // <= 0
+        if (rel < -32) {
+            int opens = __builtin_popcount((unsigned)_mm256_movemask_epi8(is_open));
+            st.bal += 2 * opens - 32;
+            continue;
+        }
+
+        __m256i delta = _mm256_blendv_epi8(minus, plus, is_open);
+        __m256i y = _mm256_sub_epi8(prefixSum32(delta), _mm256_set1_epi8((char)rel));
+        __m256i pm = prefixMinClamped32(y);
+        __m256i reset = _mm256_cmpgt_epi8(shiftUpOne32(pm), pm);
+        __m256i lr = prefixMax32(_mm256_and_si256(reset, idx));
+        __m256i match = _mm256_cmpeq_epi8(y, pm);
+        __m256i carried = _mm256_cmpeq_epi8(lr, zero);
+
+        // Coincidencias después de un reinicio dentro del bloque.
+        __m256i inner = _mm256_andnot_si256(carried, match);
+        int inner_best = horizontalMax32(_mm256_and_si256(inner, _mm256_sub_epi8(idx, lr)));
+        st.best = max(st.best, (long long)inner_best);
+
+        // Coincidencias con la base de entrada: basta la última.
+        unsigned outer = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(carried, match));
+        if (outer) {
+            int last = 31 - __builtin_clz(outer);
+            st.best = max(st.best, o + last + 1 - st.base_pos);
+        }
+
+        // Estado al final del bloque.
+        alignas(32) signed char y_out[32], pm_out[32];
+        alignas(32) unsigned char lr_out[32];
+        _mm256_store_si256((__m256i*)y_out, y);
+        _mm256_store_si256((__m256i*)pm_out, pm);
+        _mm256_store_si256((__m256i*)lr_out, lr);
+        if (pm_out[31] < 0) {
+            st.base += pm_out[31];
+            st.base_pos = o + lr_out[31];
+        }
+        st.bal += y_out[31] + rel;
+    }
+
+    // Cola que no completa un bloque de 32.
+    char open_char = reverse ? ')' : '(';
+    for (; o < n; o++) {
+        char ch = reverse ? s[n - 1 - o] : s[o];
+        scanStep(st, ch == open_char ? 1 : -1, o + 1);
+    }
+    return st.best;
+}
+#endif
+
+// Versión vectorizada: ambos escaneos con AVX2 si el CPU lo permite.
+long long longestParenthesisedSubstringSIMD(const string& s) {
+    long long n = s.size();
+    long long max_len;
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2) {
+        max_len = max(scanDirectionAVX2(s.data(), n, false), scanDirectionAVX2(s.data(), n, true));
+        return max_len == 0 ? -1 : max_len;
+    }
+#endif
+    max_len = max(scanDirectionScalar(s.data(), n, false), scanDirectionScalar(s.data(), n, true));
+    return max_len == 0 ? -1 : max_len;
+}
+
+// Largo de la subcadena válida más larga que termina en cada posición de
+// prefijo j (0 si no hay). Con reverse = true se calcula sobre la cadena
+// invertida con '(' y ')' intercambiados, lo que da el largo de la más larga
+// que EMPIEZA en cada posición (se devuelve ya en coordenadas originales).
+vector<int> longestValidEndingAt(const string& s, bool reverse) {
+    int n = s.size();
+    char open = reverse ? ')' : '(';
+    auto at = [&](int k) { return reverse ? s[n - 1 - k] : s[k]; };
+
+    vector<int> dp(n + 1, 0);  // dp[k + 1]: más larga que termina en el carácter k
+    for (int k = 1; k < n; k++) {
+        if (at(k) == open) continue;
+        int prev = dp[k];  // Más larga que termina en el carácter k - 1
+        int match = k - prev - 1;
+        if (match >= 0 && at(match) == open) {
+            dp[k + 1] = prev + 2 + dp[match];
+        }
+    }
+    if (reverse) std::reverse(dp.begin(), dp.end());
+    return dp;
+}
+
+// Índice para consultar muchas ventanas [l, r] de la misma cadena.
+// Sea m el balance mínimo dentro de la ventana (posiciones de prefijo
+// l..r+1), alcanzado por primera vez en q1 y por última en qk:
+// - (q1, qk] es válida, y ninguna subcadena válida cruza q1 ni qk (ahí el
+//   balance está en su mínimo, así que cruzarlos no cierra nada).
+// - Antes de q1 todos los balances son > m, así que la subcadena válida más
+//   larga que empieza en i < q1 termina antes de q1: basta el máximo de
+//   "más larga que empieza en i" sobre [l, q1 - 1].
+// - Simétricamente, después de qk basta el máximo de "más larga que termina
+//   en j" sobre [qk + 1, r + 1].
+// Las tres cosas salen de un árbol de segmentos sobre las posiciones de
+// prefijo, así que cada ventana se responde en O(log n) sin volver a leerla.
+class BalancedWindowIndex {
+    struct Node {
+        int min_bal;     // Balance mínimo del rango
+        int first_min;   // Primera posición con ese mínimo
+        int last_min;    // Última posición con ese mínimo
+        int best_end;    // Máximo de "más larga que termina aquí"
+        int best_start;  // Máximo de "más larga que empieza aquí"
+    };
+
+    int size;
+    vector<Node> tree;
+
+    static Node merge(const Node& a, const Node& b) {
+        Node r;
+        if (a.min_bal != b.min_bal) {
+            r = (a.min_bal < b.min_bal) ? a : b;
+        } else {
+            r = a;
+            r.first_min = min(a.first_min, b.first_min);
+            r.last_min = max(a.last_min, b.last_min);
+        }
+        r.best_end = max(a.best_end, b.best_end);
+        r.best_start = max(a.best_start, b.best_start);
+        return r;
+    }
+
+    // Combinación de las hojas [l, r] (árbol iterativo de abajo hacia arriba;
+    // 'merge' es conmutativa, así que el orden en que se juntan no importa).
+    Node range(int l, int r) const {
+        Node res = {INT_MAX, INT_MAX, -1, 0, 0};
+        for (l += size, r += size + 1; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) res = merge(res, tree[l++]);
+            if (r & 1) res = merge(res, tree[--r]);
+        }
+        return res;
+    }
+
+public:
+    explicit BalancedWindowIndex(const string& s) {
+        int n = s.size();
+        size = n + 1;
+        tree.resize(2 * size);
+
+        vector<int> ending = longestValidEndingAt(s, false);
+        vector<int> starting = longestValidEndingAt(s, true);
+        int bal = 0;
+        for (int j = 0; j <= n; j++) {
+            if (j > 0) bal += (s[j - 1] == '(') ? 1 : -1;
+            tree[size + j] = {bal, j, j, ending[j], starting[j]};
+        }
+        for (int v = size - 1; v >= 1; v--) tree[v] = merge(tree[2 * v], tree[2 * v + 1]);
+    }
+
+    // Largo de la subcadena válida más larga dentro de s[l..r] (0-indexado,
+    // inclusivo), o -1 si no hay ninguna.
+    int query(int l, int r) const {
+        Node whole = range(l, r + 1);
+        int best = whole.last_min - whole.first_min;
+        if (whole.first_min > l) {
+            best = max(best, range(l, whole.first_min - 1).best_start);
+        }
+        if (whole.last_min < r + 1) {
+            best = max(best, range(whole.last_min + 1, r + 1).best_end);
+        }
+        return best == 0 ? -1 : best;
+    }
+};
+
+#ifdef BENCHMARK
 int main() {
+    // 2^28 caracteres (256 MB): aleatorios y con mucho anidamiento.
+    const long long N = 1LL << 28;
+    mt19937_64 rng(7);
+    string random_s(N, '('), nested_s(N, '(');
+    for (long long i = 0; i < N; i += 64) {
+        unsigned long long bits = rng();
+        for (int b = 0; b < 64 && i + b < N; b++) {
+            random_s[i + b] = (bits >> b & 1) ? '(' : ')';
+        }
+    }
+    for (long long i = 0; i < N; i++) nested_s[i] = (i % 1000 < 600) ? '(' : ')';
+
+    auto seconds = [](auto start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    auto report = [N](const char* name, double secs, long long answer) {
+        cout << name << ": " << secs << " s (" << (N / secs / 1e9) << " GB/s, respuesta "
+             << answer << ")\n";
+    };
+
+    const string* inputs[] = {&random_s, &nested_s};
+    const char* names[] = {"aleatoria", "anidada"};
+    for (int k = 0; k < 2; k++) {
+        const string& s = *inputs[k];
+        cout << "cadena " << names[k] << ":\n";
+
+        auto start = chrono::steady_clock::now();
+        long long answer = longestParenthesisedSubstring(s);
+        report("  original (con copia)", seconds(start), answer);
+
+        start = chrono::steady_clock::now();
+        answer = max(scanDirectionScalar(s.data(), N, false), scanDirectionScalar(s.data(), N, true));
+        report("  escalar", seconds(start), answer);
+
+        start = chrono::steady_clock::now();
+        answer = longestParenthesisedSubstringSIMD(s);
+        report("  despachado (AVX2 si hay)", seconds(start), answer);
+
+        int threads = max(1u, thread::hardware_concurrency());
+        start = chrono::steady_clock::now();
+        answer = longestParenthesisedSubstringParallel(s, threads);
+        report("  paralela por bloques (todos los hilos)", seconds(start), answer);
+    }
+
+    // Consultas por ventanas: 10^6 ventanas sobre una cadena de 10^6.
+    const int M = 1000000, Q = 1000000;
+    string w = random_s.substr(0, M);
+    vector<pair<int, int>> windows(Q);
+    for (auto& q : windows) {
+        int a = rng() % M, b = rng() % M;
+        q = {min(a, b), max(a, b)};
+    }
+
+    auto start = chrono::steady_clock::now();
+    BalancedWindowIndex index(w);
+    cout << "índice de ventanas (n = " << M << "): construcción " << seconds(start) << " s\n";
+
+    start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (const auto& q : windows) checksum += index.query(q.first, q.second);
+    double secs = seconds(start);
+    cout << "  " << Q << " consultas: " << secs << " s (" << (Q / secs / 1e6)
+         << " M consultas/s, suma " << checksum << ")\n";
+
+    // Releer cada ventana: sólo una muestra, extrapolada.
+    const int SAMPLE = 1000;
+    start = chrono::steady_clock::now();
+    for (int k = 0; k < SAMPLE; k++) {
+        const char* p = w.data() + windows[k].first;
+        long long len = windows[k].second - windows[k].first + 1;
+        checksum += max(scanDirectionScalar(p, len, false), scanDirectionScalar(p, len, true));
+    }
+    secs = seconds(start);
+    cout << "  releyendo cada ventana: " << (SAMPLE / secs / 1e6) << " M consultas/s (suma "
+         << checksum << ")\n";
+    return 0;
+}
+#else
+int main(int argc, char* argv[]) {
     // Optimización de E/S para C++ (habitual en programación competitiva)
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
+    int threads = 1;
+    bool simd = false, queries = false;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            threads = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--simd") == 0) {
+            simd = true;
+        } else if (strcmp(argv[a], "--queries") == 0) {
+            queries = true;
+        }
+    }
+
     string s;
     // Leemos la cadena de entrada desde la consola
     if (cin >> s) {
         // Ejecutamos la función e imprimimos el resultado
-        cout << longestParenthesisedSubstring(s) << endl;
+        if (queries) {
+            BalancedWindowIndex index(s);
+            int n = s.length();
+            int q;
+            if (!(cin >> q) || q < 0) {
+                cerr << "Error: se esperaba la cantidad de consultas\n";
+                return 1;
+            }
+            string out;
+            for (int k = 0; k < q; k++) {
+                int l, r;
+                if (!(cin >> l >> r)) {
+                    cerr << "Error: faltan consultas (se leyeron " << k << " de " << q << ")\n";
+                    return 1;
+                }
+                // Validamos antes de consultar: el índice asume 0 <= l <= r < n.
+                if (l < 0 || l > r || r >= n) {
+                    cerr << "Error: consulta " << k + 1 << " fuera de rango: " << l << " " << r
+                         << " (se requiere 0 <= l <= r < " << n << ")\n";
+                    return 1;
+                }
+                out += to_string(index.query(l, r));
+                out += '\n';
+            }
+            cout << out;
+        } else if (threads > 1) {
+            cout << longestParenthesisedSubstringParallel(s, threads) << endl;
+        } else if (simd) {
+            cout << longestParenthesisedSubstringSIMD(s) << endl;
+        } else {
+            cout << longestParenthesisedSubstring(s) << endl;
+        }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -39,10 +39,47 @@
  * Total de operaciones: 10 * N = O(N).
  * - Memoria: O(1). Solo almacenamos variables primitivas (n, k, start) y un 
  * arreglo estático de 10 enteros (next_idx). No duplicamos la cadena.
+ *
+ * VERSIÓN CON PILA Y BÚFER (--stack):
+ * La versión anterior hace hasta 10 búsquedas por dígito elegido y escribe
+ * cada dígito con su propio 'cout <<'. Si aceptamos O(N) de memoria para la
+ * salida (que de todos modos mide N - K), el mismo búfer sirve de pila
+ * monotónica:
+ * - Por cada dígito, mientras queden descartes y el tope sea MENOR, lo
+ *   sacamos (ese dígito más chico no puede quedar delante de uno mayor).
+ * - Luego apilamos el dígito. Cuando K llega a 0, copiamos el resto de una vez.
+ * - Si al final sobran descartes, se quitan del final (la pila es no
+ *   creciente, así que los últimos son los más chicos).
+ * Cada dígito entra y sale de la pila a lo sumo una vez: O(1) amortizado por
+ * dígito, y el resultado se escribe con un único 'write'. Empates: sólo
+ * sacamos con '<' estricto, así que elegimos la misma aparición que la
+ * versión de 10 punteros y el resultado es idéntico.
+ * (Una tabla dispersa de máximos en rango también daría O(1) por consulta,
+ * pero con N = 10^8 necesitaría ~27 * N enteros; la pila usa N bytes.)
+ * La pila siempre lee los N dígitos; cuando K > N / 2 el resultado es corto
+ * y los 10 punteros terminan antes, así que en ese caso los usamos (también
+ * escribiendo en el búfer).
+ *
+ * VERSIÓN EN FLUJO (--stream):
+ * La pila sólo puede sacar un elemento gastando un descarte, así que de los
+ * elementos apilados sólo los K (restantes) de arriba pueden llegar a salir:
+ * todo lo que está debajo ya es definitivo. Leemos la entrada por bloques con
+ * fread y, cuando la pila llega a 2K + 64 KB, escribimos la parte definitiva
+ * y movemos los K de arriba al comienzo. Así la memoria es O(K) sin importar
+ * N, y cada mudanza de K bytes se paga con al menos K bytes escritos.
+ *
+ * Compilando con -DBENCHMARK se comparan ambas versiones con N = 10^8.
  */
 
 #include <iostream>
 #include <string>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+#ifdef BENCHMARK
+#include <chrono>
+#include <random>
+#endif
 
 using namespace std;
 
@@ -108,10 +145,196 @@ void optimalDigitsRemoval(int n, int k, const string& s) {
     cout << "\n";
 }
 
+// Escribe en 'out' (capacidad >= n) el mayor número que queda al eliminar
+// k dígitos de s[0..n-1] y devuelve su largo (n - k).
+int optimalDigitsRemovalInto(const char* s, int n, int k, char* out) {
+    int top = 0;  // Tamaño de la pila (vive en el mismo búfer de salida)
+    for (int i = 0; i < n; i++) {
+        if (k == 0) {
+            // Sin descartes: el resto de la cadena pasa tal cual.
+            memcpy(out + top, s + i, n - i);
+            top += n - i;
+            break;
+        }
+        char c = s[i];
+        while (k > 0 && top > 0 && out[top - 1] < c) {
+            top--;
+            k--;
+        }
+        out[top++] = c;
+    }
+    // Los descartes que sobren salen del final (los dígitos más chicos).
+    return top - k;
+}
+
+// Los 10 punteros de la versión original, escribiendo en 'out' (capacidad
+// >= n - k). Conviene cuando N - K es chico: sólo recorre lo necesario para
+// elegir N - K dígitos, mientras que la pila siempre lee la cadena entera.
+int optimalDigitsRemovalPointersInto(const char* s, int n, int k, char* out) {
+    int final_length = n - k;
+    int start = 0, len = 0;
+    int next_idx[10] = {0};
+    while (len < final_length) {
+        if (k == 0) {
+            memcpy(out + len, s + start, n - start);
+            len += n - start;
+            break;
+        }
+        for (int d = 9; d >= 0; d--) {
+            if (next_idx[d] < start) next_idx[d] = start;
+            while (next_idx[d] < n && s[next_idx[d]] - '0' != d) next_idx[d]++;
+            if (next_idx[d] < n && next_idx[d] - start <= k) {
+                out[len++] = '0' + d;
+                k -= next_idx[d] - start;
+                start = next_idx[d] + 1;
+                break;
+            }
+        }
+    }
+    return len;
+}
+
+void optimalDigitsRemovalBuffered(int n, int k, const string& s) {
+    if (n - k <= 0) return;
+    // Preasignado: el resultado (o la pila) más el salto de línea
+    string out((k > n / 2 ? n - k : n) + 1, '\0');
+    int len = (k > n / 2) ? optimalDigitsRemovalPointersInto(s.data(), n, k, &out[0])
+                          : optimalDigitsRemovalInto(s.data(), n, k, &out[0]);
+    out[len] = '\n';
+    cout.write(out.data(), len + 1);
+}
+
+// Lector por bloques: entrega un carácter a la vez sin pasar por cin.
+struct ByteReader {
+    FILE* in;
+    char buf[1 << 16];
+    size_t len = 0, pos = 0;
+
+    explicit ByteReader(FILE* f) : in(f) {}
+
+    int next() {
+        if (pos == len) {
+            len = fread(buf, 1, sizeof(buf), in);
+            pos = 0;
+            if (len == 0) return EOF;
+        }
+        return (unsigned char)buf[pos++];
+    }
+
+    // Siguiente entero no negativo (salta lo que no sea dígito).
+    bool readInt(int& value) {
+        int c = next();
+        while (c != EOF && (c < '0' || c > '9')) c = next();
+        if (c == EOF) return false;
+        value = 0;
+        for (; c >= '0' && c <= '9'; c = next()) value = value * 10 + (c - '0');
+        return true;
+    }
+};
+
+// Lee "N K" y los N dígitos de 'in' y escribe el resultado en 'out' usando
+// memoria O(K): sólo guardamos la parte de la pila que todavía puede cambiar.
+void optimalDigitsRemovalStream(FILE* in, FILE* out) {
+    ByteReader reader(in);
+    int n, k;
+    if (!reader.readInt(n) || !reader.readInt(k)) return;
+    if (n - k <= 0) return;
+
+    const size_t capacity = 2 * (size_t)k + (1 << 16);
+    vector<char> stack(capacity);
+    size_t top = 0;
+    int remaining = n;
+    while (remaining > 0) {
+        int c = reader.next();
+        if (c == EOF) break;
+        if (c < '0' || c > '9') continue;
+        remaining--;
+
+        while (k > 0 && top > 0 && stack[top - 1] < c) {
+            top--;
+            k--;
+        }
+        stack[top++] = (char)c;
+
+        if (top == capacity) {
+            // Todo salvo los K de arriba es definitivo: lo escribimos.
+            size_t done = top - k;
+            fwrite(stack.data(), 1, done, out);
+            memmove(stack.data(), stack.data() + done, k);
+            top = k;
+        }
+    }
+    // Los descartes que sobren salen del final.
+    fwrite(stack.data(), 1, top - k, out);
+    fputc('\n', out);
+}
+
+#ifdef BENCHMARK
+// Descarta todo lo que se escribe, con un búfer como el de un archivo real,
+// para medir el costo de formatear la salida sin depender del disco.
+struct NullBuffer : streambuf {
+    char buf[1 << 16];
+    NullBuffer() { setp(buf, buf + sizeof(buf)); }
+    int overflow(int c) override {
+        setp(buf, buf + sizeof(buf));
+        return c;
+    }
+    streamsize xsputn(const char*, streamsize count) override { return count; }
+};
+
 int main() {
+    ios_base::sync_with_stdio(false);
+    const int N = 100000000;
+    mt19937 rng(7);
+    string s(N, '0');
+    for (int i = 0; i < N; i++) s[i] = '0' + rng() % 10;
+
+    auto seconds = [](auto start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    NullBuffer sink;
+    streambuf* original = cout.rdbuf(&sink);
+    const int ks[] = {1000, N / 2, N - 1000};
+    double times[3][2];
+    for (int t = 0; t < 3; t++) {
+        auto start = chrono::steady_clock::now();
+        optimalDigitsRemoval(N, ks[t], s);
+        times[t][0] = seconds(start);
+
+        start = chrono::steady_clock::now();
+        optimalDigitsRemovalBuffered(N, ks[t], s);
+        times[t][1] = seconds(start);
+    }
+    cout.rdbuf(original);
+
+    for (int t = 0; t < 3; t++) {
+        cout << "N = " << N << ", K = " << ks[t] << ": 10 punteros " << times[t][0]
+             << " s, pila + búfer " << times[t][1] << " s\n";
+    }
+    return 0;
+}
+#else
+int main(int argc, char* argv[]) {
     // Optimización de I/O para programación competitiva
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
+
+    bool use_stack = false, stream = false;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--stack") == 0) {
+            use_stack = true;
+        } else if (strcmp(argv[a], "--stream") == 0) {
+            stream = true;
+        } else {
+            cerr << "Opción desconocida: " << argv[a] << " (use --stack o --stream)\n";
+            return 1;
+        }
+    }
+    if (stream) {
+        optimalDigitsRemovalStream(stdin, stdout);
+        return 0;
+    }
     
     int n, k;
     // Leemos N y K
@@ -121,8 +344,13 @@ int main() {
         cin >> s;
         
         // Ejecutamos la función
-        optimalDigitsRemoval(n, k, s);
+        if (use_stack) {
+            optimalDigitsRemovalBuffered(n, k, s);
+        } else {
+            optimalDigitsRemoval(n, k, s);
+        }
     }
     
     return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -48,12 +48,49 @@
  * LPS toman tiempo estrictamente lineal respecto al tamaño de S.
  * - Memoria: O(N) para almacenar las cadenas temporales y el arreglo LPS, lo
  * cual es óptimo y respeta holgadamente el límite de 128 MB.
+ *
+ * VERSIÓN SIN COPIAS (--lean):
+ * Las cadenas temporales sólo existen para que un único arreglo LPS haga dos
+ * trabajos: el de la función de prefijos del patrón y el de la búsqueda en
+ * el texto. Con KMP "clásico" los separamos y no hace falta concatenar:
+ * - Prefijo: patrón S, texto Reverso(S). Tras recorrer todo el texto, el
+ *   largo emparejado es el prefijo de S más largo que es sufijo de
+ *   Reverso(S), es decir, el prefijo palindrómico más largo.
+ * - Sufijo: patrón Reverso(S), texto S.
+ * Reverso(S) nunca se construye: lo leemos como s[n - 1 - i]. Sólo usamos un
+ * arreglo de N enteros, reutilizado para ambas pasadas (en vez de ~6N bytes
+ * de cadenas más dos arreglos de 2N + 1 enteros), y cada pasada recorre N + N
+ * caracteres en lugar de 2N + 1 + 2N + 1 con sus copias.
+ *
+ * CONSULTAS SOBRE SUBCADENAS (--queries):
+ * Para muchas subcadenas T = S[l..r] del mismo texto, preprocesamos S una
+ * vez con Manacher. Numeramos los centros c = i + j (el palíndromo S[i..j]
+ * tiene centro c), y para cada centro guardamos dónde empieza y termina su
+ * palíndromo maximal: izq(c) y der(c).
+ * - S[l..l+L-1] es palíndromo si y sólo si su centro c = 2l + L - 1 cumple
+ *   izq(c) <= l. El prefijo palindrómico más largo de T sale entonces del
+ *   MAYOR c en [2l, l + r] con izq(c) <= l.
+ * - Simétricamente, el sufijo más largo sale del MENOR c en [l + r, 2r] con
+ *   der(c) >= r.
+ * Ambas búsquedas se hacen bajando por un árbol de segmentos (mínimos de izq
+ * y máximos de der) en O(log N) por consulta y O(N) de memoria.
+ * Entrada: S, Q, y luego Q pares "l r" (0-indexados, inclusivos). Si algún
+ * par no cumple 0 <= l <= r < N el programa termina con un error.
+ *
+ * Compilando con -DBENCHMARK se comparan ambas versiones con N = 10^8, y se
+ * miden 10^6 consultas sobre un texto de 10^6 caracteres.
  */
 
 #include <iostream>
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstring>
+#include <climits>
+#ifdef BENCHMARK
+#include <chrono>
+#include <random>
+#endif
 
 using namespace std;
 
@@ -109,17 +146,248 @@ int minCharsToPalindrome(string s) {
     return n - max_palindromic_part;
 }
 
+// Largo del prefijo (Suffix = false) o sufijo (Suffix = true) palindrómico
+// más largo de s, con KMP sobre vistas de s sin copiarla. 'pi' es memoria de
+// trabajo de tamaño >= n, para poder reutilizarla entre llamadas. La
+// dirección es un parámetro de plantilla para que los accesos no tengan saltos.
+template <bool Suffix>
+int longestPalindromicEnd(const string& s, vector<int>& pi) {
+    int n = s.length();
+    const char* p = s.data();
+    // Patrón y texto: uno es s y el otro su reverso.
+    auto pattern = [&](int i) { return Suffix ? p[n - 1 - i] : p[i]; };
+    auto text = [&](int i) { return Suffix ? p[i] : p[n - 1 - i]; };
+
+    // Función de prefijos del patrón (la misma recurrencia que computeLPS).
+    pi[0] = 0;
+    for (int i = 1, len = 0; i < n; i++) {
+        char c = pattern(i);
+        while (len > 0 && c != pattern(len)) len = pi[len - 1];
+        if (c == pattern(len)) len++;
+        pi[i] = len;
+    }
+
+    // Recorremos el texto; como mide lo mismo que el patrón, sólo puede
+    // emparejarse completo en el último carácter.
+    int matched = 0;
+    for (int i = 0; i < n; i++) {
+        char c = text(i);
+        while (matched > 0 && c != pattern(matched)) matched = pi[matched - 1];
+        if (c == pattern(matched)) matched++;
+    }
+    return matched;
+}
+
+int minCharsToPalindromeLean(const string& s) {
+    int n = s.length();
+    if (n <= 1) return 0;
+
+    vector<int> pi(n);
+    int longest_palindromic_prefix = longestPalindromicEnd<false>(s, pi);
+    int longest_palindromic_suffix = longestPalindromicEnd<true>(s, pi);
+    return n - max(longest_palindromic_prefix, longest_palindromic_suffix);
+}
+
+// Índice de Manacher para consultar subcadenas de un mismo texto.
+class PalindromeQueryIndex {
+    int centers;            // 2N - 1 centros
+    int size;               // Hojas del árbol (potencia de 2)
+    vector<int> min_left;   // Árbol de mínimos de izq(c)
+    vector<int> max_right;  // Árbol de máximos de der(c)
+
+    // Mayor c en [a, b] con izq(c) <= x, o -1.
+    int lastLeftAtMost(int node, int nl, int nr, int a, int b, int x) const {
+        if (nr < a || nl > b || min_left[node] > x) return -1;
+        if (nl == nr) return nl;
+        int mid = (nl + nr) / 2;
+        int res = lastLeftAtMost(2 * node + 1, mid + 1, nr, a, b, x);
+        if (res != -1) return res;
+        return lastLeftAtMost(2 * node, nl, mid, a, b, x);
+    }
+
+    // Menor c en [a, b] con der(c) >= x, o -1.
+    int firstRightAtLeast(int node, int nl, int nr, int a, int b, int x) const {
+        if (nr < a || nl > b || max_right[node] < x) return -1;
+        if (nl == nr) return nl;
+        int mid = (nl + nr) / 2;
+        int res = firstRightAtLeast(2 * node, nl, mid, a, b, x);
+        if (res != -1) return res;
+        return firstRightAtLeast(2 * node + 1, mid + 1, nr, a, b, x);
+    }
+
+public:
+    explicit PalindromeQueryIndex(const string& s) {
+        int n = s.length();
+        centers = max(1, 2 * n - 1);
+        size = 1;
+        while (size < centers) size *= 2;
+        min_left.assign(2 * size, INT_MAX);
+        max_right.assign(2 * size, INT_MIN);
+
+        // Manacher: d1[i] = radio del palíndromo impar con centro en i
+        // (contando el centro), d2[i] = radio del par centrado entre i-1 e i.
+        vector<int> d1(n), d2(n);
+        for (int i = 0, l = 0, r = -1; i < n; i++) {
+            int k = (i > r) ? 1 : min(d1[l + r - i], r - i + 1);
+            while (i - k >= 0 && i + k < n && s[i - k] == s[i + k]) k++;
+            d1[i] = k;
+            if (i + k - 1 > r) {
+                l = i - k + 1;
+                r = i + k - 1;
+            }
+        }
+        for (int i = 0, l = 0, r = -1; i < n; i++) {
+            int k = (i > r) ? 0 : min(d2[l + r - i + 1], r - i + 1);
+            while (i - k - 1 >= 0 && i + k < n && s[i - k - 1] == s[i + k]) k++;
+            d2[i] = k;
+            if (i + k - 1 > r) {
+                l = i - k;
+                r = i + k - 1;
+            }
+        }
+
+        // Centro 2i: palíndromo impar; centro 2i - 1: par (puede ser vacío,
+        // con izq = i y der = i - 1, que nunca pasa los filtros).
+        for (int i = 0; i < n; i++) {
+            min_left[size + 2 * i] = i - d1[i] + 1;
+            max_right[size + 2 * i] = i + d1[i] - 1;
+            if (i > 0) {
+                min_left[size + 2 * i - 1] = i - d2[i];
+                max_right[size + 2 * i - 1] = i + d2[i] - 1;
+            }
+        }
+        for (int v = size - 1; v >= 1; v--) {
+            min_left[v] = min(min_left[2 * v], min_left[2 * v + 1]);
+            max_right[v] = max(max_right[2 * v], max_right[2 * v + 1]);
+        }
+    }
+
+    // Prefijo palindrómico más largo de S[l..r].
+    int longestPrefix(int l, int r) const {
+        int c = lastLeftAtMost(1, 0, size - 1, 2 * l, l + r, l);
+        return c - 2 * l + 1;  // Siempre existe: c = 2l (una sola letra)
+    }
+
+    // Sufijo palindrómico más largo de S[l..r].
+    int longestSuffix(int l, int r) const {
+        int c = firstRightAtLeast(1, 0, size - 1, l + r, 2 * r, r);
+        return 2 * r - c + 1;
+    }
+
+    // Caracteres a agregar para que S[l..r] sea palíndromo.
+    int minCharsToPalindrome(int l, int r) const {
+        return (r - l + 1) - max(longestPrefix(l, r), longestSuffix(l, r));
+    }
+};
+
+#ifdef BENCHMARK
 int main() {
+    // 10^8 caracteres: 'a'/'b' al azar (muchos retrocesos en KMP) con un
+    // palíndromo largo al comienzo para que la respuesta no sea trivial.
+    const int N = 100000000;
+    mt19937 rng(7);
+    string s(N, 'a');
+    for (int i = 0; i < N; i++) s[i] = (rng() & 1) ? 'a' : 'b';
+    for (int i = 0; i < N / 4; i++) s[N / 2 - 1 - i] = s[i];
+
+    auto seconds = [](auto start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    auto start = chrono::steady_clock::now();
+    int answer = minCharsToPalindrome(s);
+    cout << "con concatenaciones: " << seconds(start) << " s (respuesta " << answer << ")\n";
+
+    start = chrono::steady_clock::now();
+    answer = minCharsToPalindromeLean(s);
+    cout << "sin copias: " << seconds(start) << " s (respuesta " << answer << ")\n";
+
+    // Consultas: 10^6 subcadenas al azar de un texto de 10^6 caracteres.
+    const int M = 1000000, Q = 1000000;
+    string text = s.substr(0, M);
+    vector<pair<int, int>> queries(Q);
+    for (auto& q : queries) {
+        int a = rng() % M, b = rng() % M;
+        q = {min(a, b), max(a, b)};
+    }
+
+    start = chrono::steady_clock::now();
+    PalindromeQueryIndex index(text);
+    cout << "índice (n = " << M << "): construcción " << seconds(start) << " s\n";
+
+    start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (const auto& q : queries) checksum += index.minCharsToPalindrome(q.first, q.second);
+    double secs = seconds(start);
+    cout << "  " << Q << " consultas: " << secs << " s (" << (Q / secs / 1e6)
+         << " M consultas/s, suma " << checksum << ")\n";
+
+    // Recalcular cada subcadena desde cero: sólo una muestra, extrapolada.
+    const int SAMPLE = 1000;
+    start = chrono::steady_clock::now();
+    for (int k = 0; k < SAMPLE; k++) {
+        string t = text.substr(queries[k].first, queries[k].second - queries[k].first + 1);
+        checksum += minCharsToPalindromeLean(t);
+    }
+    secs = seconds(start);
+    cout << "  recalculando cada subcadena: " << (SAMPLE / secs / 1e6)
+         << " M consultas/s (suma " << checksum << ")\n";
+    return 0;
+}
+#else
+int main(int argc, char* argv[]) {
     // Optimización de I/O para programación competitiva
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
+    bool lean = false, queries = false;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--lean") == 0) {
+            lean = true;
+        } else if (strcmp(argv[a], "--queries") == 0) {
+            queries = true;
+        } else {
+            cerr << "Opción desconocida: " << argv[a] << " (use --lean o --queries)\n";
+            return 1;
+        }
+    }
+
     string s;
     // Leemos la cadena S
     if (cin >> s) {
         // Ejecutamos la función e imprimimos el resultado
-        cout << minCharsToPalindrome(s) << "\n";
+        if (queries) {
+            PalindromeQueryIndex index(s);
+            int n = s.length();
+            int q;
+            if (!(cin >> q) || q < 0) {
+                cerr << "Error: se esperaba la cantidad de consultas\n";
+                return 1;
+            }
+            string out;
+            for (int k = 0; k < q; k++) {
+                int l, r;
+                if (!(cin >> l >> r)) {
+                    cerr << "Error: faltan consultas (se leyeron " << k << " de " << q << ")\n";
+                    return 1;
+                }
+                // Validamos antes de consultar: el índice asume 0 <= l <= r < n.
+                if (l < 0 || l > r || r >= n) {
+                    cerr << "Error: consulta " << k + 1 << " fuera de rango: " << l << " " << r
+                         << " (se requiere 0 <= l <= r < " << n << ")\n";
+                    return 1;
+                }
+                out += to_string(index.minCharsToPalindrome(l, r));
+                out += '\n';
+            }
+            cout << out;
+        } else if (lean) {
+            cout << minCharsToPalindromeLean(s) << "\n";
+        } else {
+            cout << minCharsToPalindrome(s) << "\n";
+        }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
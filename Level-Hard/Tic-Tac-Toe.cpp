@@ -44,11 +44,32 @@
  * de escala algorítmica.
  * - Memoria: O(1) de espacio extra, ya que la pila de recursión llega a un 
  * máximo de 9 niveles de profundidad.
+ *
+ * VERSIÓN CON BITBOARDS Y TABLA DE TRANSPOSICIÓN (--bitboard):
+ * El Minimax anterior vuelve a explorar las mismas posiciones muchas veces
+ * (a una posición se llega por varios órdenes de jugadas) y en cada nodo
+ * recorre la matriz para ver si alguien ganó o si está lleno.
+ * - Cada jugador es una máscara de 9 bits (bit 3 * fila + columna). Ganar es
+ *   que alguna de las 8 máscaras de línea esté contenida en la del jugador.
+ * - Cada posición tiene un índice en base 3 (0 vacío, 1, 2) < 3^9 = 19683, y
+ *   una tabla de 19683 bytes guarda su resultado. El turno no hace falta en
+ *   la clave: se deduce de la cantidad de fichas.
+ * - Un precálculo desde el tablero vacío, explorando TODAS las jugadas (sin
+ *   cortar al encontrar una victoria, para no dejar ramas sin visitar), llena
+ *   la tabla con las 5478 posiciones alcanzables. Todo tablero que pasa la
+ *   validación es alcanzable, así que después resolver cualquier tablero es
+ *   validar con popcount y leer la tabla.
+ *
+ * Compilando con -DBENCHMARK se resuelven los 3^9 tableros con ambas versiones.
  */
 
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <cstring>
+#ifdef BENCHMARK
+#include <chrono>
+#endif
 
 using namespace std;
 
@@ -163,11 +184,149 @@ int solveTicTacToe(vector<vector<int>>& board) {
     else return 0;                   // Empate
 }
 
+// ---------------------------------------------------------------------------
+// Versión con bitboards
+// ---------------------------------------------------------------------------
+
+// Las 8 líneas ganadoras: 3 filas, 3 columnas y 2 diagonales.
+const int WIN_MASKS[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
+const int FULL_BOARD = 0x1FF;
+const int POW3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+const signed char UNKNOWN = 2;
+
+// Tabla de transposición indexada por la posición en base 3.
+signed char memo[19683];
+
+bool hasWin(int mask) {
+    for (int w : WIN_MASKS) {
+        if ((mask & w) == w) return true;
+    }
+    return false;
+}
+
+// Minimax con memoización. x y o son las máscaras de cada jugador y key el
+// índice en base 3 de la posición. Mismo resultado que minimax().
+int minimaxBits(int x, int o, int key, int turn) {
+    signed char& entry = memo[key];
+    if (entry != UNKNOWN) return entry;
+
+    int result;
+    if (hasWin(x)) {
+        result = 1;
+    } else if (hasWin(o)) {
+        result = -1;
+    } else if ((x | o) == FULL_BOARD) {
+        result = 0;
+    } else if (turn == 1) {
+        result = -2;
+        for (int free = FULL_BOARD & ~(x | o); free; free &= free - 1) {
+            int cell = __builtin_ctz(free);
+            result = max(result, minimaxBits(x | (1 << cell), o, key + POW3[cell], 2));
+        }
+    } else {
+        result = 2;
+        for (int free = FULL_BOARD & ~(x | o); free; free &= free - 1) {
+            int cell = __builtin_ctz(free);
+            result = min(result, minimaxBits(x, o | (1 << cell), key + 2 * POW3[cell], 1));
+        }
+    }
+    entry = result;
+    return result;
+}
+
+// Precálculo único: resuelve todas las posiciones alcanzables. minimaxBits no
+// corta la búsqueda, así que visita (y guarda) cada una.
+void precomputeTicTacToe() {
+    static bool done = false;
+    if (done) return;
+    memset(memo, UNKNOWN, sizeof(memo));
+    minimaxBits(0, 0, 0, 1);
+    done = true;
+}
+
+int solveTicTacToeBits(const vector<vector<int>>& board) {
+    precomputeTicTacToe();
+
+    // La tabla sólo cubre celdas 0, 1 y 2. El original trata cualquier otro
+    // valor como una celda ocupada por nadie; esos tableros (que no entran en
+    // la clave en base 3) los resuelve la versión original.
+    for (const auto& row : board) {
+        for (int v : row) {
+            if (v < 0 || v > 2) {
+                vector<vector<int>> copy = board;
+                return solveTicTacToe(copy);
+            }
+        }
+    }
+
+    int x = 0, o = 0, key = 0;
+    for (int cell = 0; cell < 9; cell++) {
+        int v = board[cell / 3][cell % 3];
+        if (v == 1) x |= 1 << cell;
+        else if (v == 2) o |= 1 << cell;
+        key += v * POW3[cell];  // 0 <= key < 3^9: cada v está en {0, 1, 2}
+    }
+
+    // Las mismas reglas que isValidState().
+    int count1 = __builtin_popcount(x), count2 = __builtin_popcount(o);
+    if (count1 != count2 && count1 != count2 + 1) return -1;
+    bool win1 = hasWin(x), win2 = hasWin(o);
+    if (win1 && win2) return -1;
+    if (win1 && count1 != count2 + 1) return -1;
+    if (win2 && count1 != count2) return -1;
+
+    // Todo tablero válido es alcanzable, así que ya está en la tabla.
+    int result = memo[key];
+    if (result == 1) return 1;
+    else if (result == -1) return 2;
+    else return 0;
+}
+
+#ifdef BENCHMARK
 int main() {
+    auto seconds = [](auto start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    // Los 3^9 tableros posibles (válidos o no).
+    vector<vector<vector<int>>> boards;
+    for (int code = 0; code < 19683; code++) {
+        vector<vector<int>> board(3, vector<int>(3));
+        for (int cell = 0, c = code; cell < 9; cell++, c /= 3) board[cell / 3][cell % 3] = c % 3;
+        boards.push_back(board);
+    }
+
+    auto start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (auto& board : boards) checksum += solveTicTacToe(board);
+    cout << "minimax original: " << seconds(start) << " s (suma " << checksum << ")\n";
+
+    start = chrono::steady_clock::now();
+    precomputeTicTacToe();
+    cout << "precálculo bitboard: " << seconds(start) << " s\n";
+
+    start = chrono::steady_clock::now();
+    checksum = 0;
+    for (auto& board : boards) checksum += solveTicTacToeBits(board);
+    cout << "bitboard + tabla: " << seconds(start) << " s (suma " << checksum << ")\n";
+    return 0;
+}
+#else
+int main(int argc, char* argv[]) {
     // Optimización de I/O
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
+    bool bitboard = false;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--bitboard") == 0) {
+            bitboard = true;
+        } else {
+            cerr << "Opción desconocida: " << argv[a] << " (use --bitboard)\n";
+            return 1;
+        }
+    }
+
     vector<vector<int>> board(3, vector<int>(3));
     
     // Validamos que se pueda leer el tablero
@@ -180,8 +339,9 @@ int main() {
         }
         
         // Ejecutamos la solución e imprimimos el resultado
-        cout << solveTicTacToe(board) << "\n";
+        cout << (bitboard ? solveTicTacToeBits(board) : solveTicTacToe(board)) << "\n";
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -37,9 +37,23 @@
  * FÓRMULA FINAL:
  * suma(n) = (k * k) + suma(n / 2)
  * donde k = (n + 1) / 2.
+ *
+ * VERSIÓN ITERATIVA CON 128 BITS:
+ * Si desenrollamos la recursión, suma(n) es simplemente:
+ * suma(n) = k0^2 + k1^2 + k2^2 + ...,  donde kj = ceil((n >> j) / 2).
+ * Como n >> j llega a 0 en a lo más 64 pasos, podemos hacer SIEMPRE 64
+ * iteraciones sin ningún 'if' (los términos sobrantes valen 0). Eso evita
+ * la cadena de llamadas y deja un bucle fijo que el compilador desenrolla.
+ *
+ * Para B cercano a 10^18 (o hasta 2^64 - 1), k*k y la suma total ya no caben
+ * en long long: suma(n) es aproximadamente n^2 / 3 ~ 1.1 * 10^38, que sí
+ * cabe en unsigned __int128 (hasta ~3.4 * 10^38). Así que acumulamos ahí.
  */
 
 #include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
 
 using namespace std;
 
@@ -67,6 +81,53 @@ long long sumOddDivisors(long long n) {
     return sumOdds + sumEvens;
 }
 
+typedef unsigned long long u64;
+typedef unsigned __int128 u128;
+
+// Versión iterativa y sin ramas de sumOddDivisors, exacta para todo n de 64 bits.
+u128 sumOddDivisorsWide(u64 n) {
+    u128 total = 0;
+    for (int j = 0; j < 64; j++) {
+        u64 m = n >> j;
+        // ceil(m / 2) sin calcular m + 1 (que desborda si m = 2^64 - 1).
+        u64 k = (m >> 1) + (m & 1);
+        total += (u128)k * k;
+    }
+    return total;
+}
+
+// Evalúa muchas consultas [A[i], B[i]] a la vez: out[i] = suma(B) - suma(A - 1).
+// Ambos extremos se procesan en el mismo bucle de 64 pasos, que no tiene
+// ramas ni dependencias entre consultas, así que el compilador puede
+// vectorizar el recorrido sobre 'i'.
+void sumOddDivisorsBatch(const u64* A, const u64* B, u128* out, size_t q) {
+    for (size_t i = 0; i < q; i++) {
+        // Si A = 0 el prefijo izquierdo es suma(0) = 0 (evitamos 0 - 1).
+        u64 lo = A[i] - (A[i] != 0);
+        u64 hi = B[i];
+        u128 total = 0;
+        for (int j = 0; j < 64; j++) {
+            u64 mh = hi >> j, ml = lo >> j;
+            u64 kh = (mh >> 1) + (mh & 1);
+            u64 kl = (ml >> 1) + (ml & 1);
+            total += (u128)kh * kh - (u128)kl * kl;
+        }
+        out[i] = total;
+    }
+}
+
+// cout no sabe imprimir __int128, así que lo convertimos a texto a mano.
+string toString(u128 x) {
+    if (x == 0) return "0";
+    string digits;
+    while (x > 0) {
+        digits += (char)('0' + (int)(x % 10));
+        x /= 10;
+    }
+    reverse(digits.begin(), digits.end());
+    return digits;
+}
+
 int main() {
     // Optimización de I/O para manejar 10^5 casos de prueba rápidamente.
     ios_base::sync_with_stdio(false);
@@ -74,15 +135,19 @@ int main() {
 
     int T;
     if (cin >> T) {
-        while (T--) {
-            long long A, B;
-            cin >> A >> B;
+        // Leemos todas las consultas primero para resolverlas en lote.
+        vector<u64> A(T), B(T);
+        for (int i = 0; i < T; i++) {
+            cin >> A[i] >> B[i];
+        }
 
-            // Calculamos la respuesta usando la resta de rangos.
-            // Suma en [A, B] = Suma en [1, B] - Suma en [1, A-1]
-            long long result = sumOddDivisors(B) - sumOddDivisors(A - 1);
+        // Calculamos la respuesta usando la resta de rangos.
+        // Suma en [A, B] = Suma en [1, B] - Suma en [1, A-1]
+        vector<u128> result(T);
+        sumOddDivisorsBatch(A.data(), B.data(), result.data(), T);
 
-            cout << result << "\n";
+        for (int i = 0; i < T; i++) {
+            cout << toString(result[i]) << "\n";
         }
     }
     return 0;
@@ -41,11 +41,60 @@
  * COMPLEJIDAD:
  * Tiempo: O(N * N!) en el peor caso (todos distintos), pero mucho menos con duplicados.
  * Es óptimo O(output_size) porque nunca generamos una rama inválida.
+ *
+ * VERSIÓN ITERATIVA (Siguiente Permutación sobre el multiconjunto):
+ * La recursión anterior recorre los N índices en cada nivel y salta los
+ * gemelos uno por uno. Una alternativa sin recursión es partir del arreglo
+ * ordenado (la menor permutación) y aplicar "siguiente permutación"
+ * repetidamente:
+ * 1. Buscar desde la derecha el primer i con nums[i] < nums[i+1].
+ * 2. Buscar desde la derecha el primer j con nums[j] > nums[i] e intercambiar.
+ * 3. Invertir el sufijo nums[i+1..N-1].
+ * Usando comparaciones estrictas, los valores repetidos nunca generan la
+ * misma permutación dos veces, y el costo amortizado por permutación es O(1)
+ * (el sufijo que se modifica es corto casi siempre).
+ *
+ * Además, como sólo cambia el sufijo desde 'i', la línea de texto anterior
+ * comparte su prefijo con la nueva: copiamos ese prefijo tal cual y sólo
+ * formateamos los números desde 'i', escribiendo directo en un búfer de
+ * salida que se vuelca con una sola escritura cada cierto tamaño.
+ *
+ * RANGO (RANK) Y PARALELISMO:
+ * La cantidad de permutaciones únicas de un multiconjunto con conteos
+ * c1, c2, ..., cd (que suman m) es el multinomial  m! / (c1! * c2! * ... * cd!).
+ * Las que empiezan con el valor v son exactamente  total * cv / m, así que
+ * podemos calcular en O(N * d) la posición (rank) de una permutación dentro
+ * del orden lexicográfico, y también el camino inverso (unrank): dada una
+ * posición, construir la permutación eligiendo valor por valor.
+ * Con eso el espacio de salida [0, total) se corta en rangos contiguos, cada
+ * hilo arranca en el unrank de su inicio y genera su rango en un búfer propio,
+ * y al final los búferes se escriben en orden. También permite reanudar una
+ * enumeración desde cualquier posición.
+ *
+ * MODOS (argumentos de línea de comandos; sin argumentos se comporta igual
+ * que siempre):
+ *   --count          Sólo imprime cuántas permutaciones únicas hay (exacto
+ *                    para cualquier N).
+ *   --threads T      Reparte la enumeración entre T hilos.
+ *   --range L R      Imprime sólo las permutaciones con rank en [L, R).
+ * --threads y --range trabajan con ranks de 128 bits: si hay 2^128
+ * permutaciones o más, terminan con un error en vez de dar rangos erróneos.
+ *
+ * Compilando con -DBENCHMARK se comparan ambas versiones con N = 12 y muchos
+ * duplicados.
  */
 
 #include <iostream>
 #include <vector>
+#include <string>
 #include <algorithm> // Para sort
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+#ifdef BENCHMARK
+#include <chrono>
+#include <sstream>
+#endif
 
 using namespace std;
 
@@ -99,7 +148,368 @@ void generatePermutations() {
     }
 }
 
+// Avanza 'p' a la siguiente permutación distinta en orden lexicográfico.
+// Retorna el índice desde el cual cambió el arreglo, o -1 si 'p' ya era la última.
+int nextMultisetPermutation(vector<int>& p) {
+    int n = p.size();
+    int i = n - 2;
+    while (i >= 0 && p[i] >= p[i + 1]) i--;
+    if (i < 0) return -1;
+
+    int j = n - 1;
+    while (p[j] <= p[i]) j--;
+    swap(p[i], p[j]);
+    reverse(p.begin() + i + 1, p.end());
+    return i;
+}
+
+// Cantidades de permutaciones: el multinomial crece muy rápido, así que
+// usamos 128 bits (alcanza para N = 34 con todos los valores distintos).
+// countPermutations detecta cuándo no alcanza: entonces --count usa
+// BigUnsigned, y --range / --threads (que necesitan ranks de 128 bits) se
+// rechazan con un error.
+typedef unsigned __int128 u128;
+
+// Entero sin signo de precisión arbitraria (dígitos de 32 bits), sólo con lo
+// necesario para el multinomial: multiplicar y dividir por enteros chicos.
+struct BigUnsigned {
+    vector<unsigned int> d;
+
+    BigUnsigned(unsigned long long v = 0) {
+        while (v > 0) {
+            d.push_back((unsigned int)v);
+            v >>= 32;
+        }
+    }
+
+    bool isZero() const { return d.empty(); }
+
+    void trim() {
+        while (!d.empty() && d.back() == 0) d.pop_back();
+    }
+
+    void mulSmall(unsigned int m) {
+        unsigned long long carry = 0;
+        for (size_t i = 0; i < d.size(); i++) {
+            carry += (unsigned long long)d[i] * m;
+            d[i] = (unsigned int)carry;
+            carry >>= 32;
+        }
+        if (carry) d.push_back((unsigned int)carry);
+        trim();
+    }
+
+    // Divide entre 'm' y retorna el residuo.
+    unsigned int divSmall(unsigned int m) {
+        unsigned long long rem = 0;
+        for (int i = (int)d.size() - 1; i >= 0; i--) {
+            unsigned long long cur = (rem << 32) | d[i];
+            d[i] = (unsigned int)(cur / m);
+            rem = cur % m;
+        }
+        trim();
+        return (unsigned int)rem;
+    }
+
+    string toString() const {
+        if (isZero()) return "0";
+        BigUnsigned t = *this;
+        string digits;
+        while (!t.isZero()) {
+            unsigned int chunk = t.divSmall(1000000000);
+            for (int k = 0; k < 9; k++) {
+                digits += (char)('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+        while (digits.size() > 1 && digits.back() == '0') digits.pop_back();
+        reverse(digits.begin(), digits.end());
+        return digits;
+    }
+};
+
+// total * num / den sabiendo que el resultado es entero, sin formar el
+// producto completo: con g = mcd(num, den), den / g divide a total.
+// Retorna false si el resultado no cabe en 128 bits.
+bool mulDivExact(u128 total, int num, int den, u128& result) {
+    int g = __gcd(num, den);
+    return !__builtin_mul_overflow(total / (u128)(den / g), (u128)(num / g), &result);
+}
+
+// Valores distintos (ordenados) y cuántas veces aparece cada uno.
+void groupValues(const vector<int>& sorted_nums, vector<int>& values, vector<int>& counts) {
+    values.clear();
+    counts.clear();
+    for (int v : sorted_nums) {
+        if (values.empty() || values.back() != v) {
+            values.push_back(v);
+            counts.push_back(0);
+        }
+        counts.back()++;
+    }
+}
+
+// Multinomial m! / (c1! * ... * cd!), armado como producto de binomiales
+// C(c1, c1) * C(c1 + c2, c2) * ... para que cada división sea exacta.
+// Retorna false si no cabe en 128 bits.
+bool countPermutations(const vector<int>& counts, u128& total) {
+    total = 1;
+    int placed = 0;
+    for (int c : counts) {
+        for (int k = 1; k <= c; k++) {
+            placed++;
+            if (!mulDivExact(total, placed, k, total)) return false;
+        }
+    }
+    return true;
+}
+
+// El mismo multinomial sin límite de tamaño (para --count).
+BigUnsigned countPermutationsBig(const vector<int>& counts) {
+    BigUnsigned total(1);
+    int placed = 0;
+    for (int c : counts) {
+        for (int k = 1; k <= c; k++) {
+            placed++;
+            total.mulSmall(placed);
+            total.divSmall(k);
+        }
+    }
+    return total;
+}
+
+// Posición (0-indexada) de 'perm' entre las permutaciones únicas de su
+// multiconjunto, en orden lexicográfico. Requiere que countPermutations quepa
+// en 128 bits; los productos intermedios no desbordan (ver mulDivExact).
+u128 rankPermutation(const vector<int>& perm) {
+    vector<int> sorted_perm = perm, values, counts;
+    sort(sorted_perm.begin(), sorted_perm.end());
+    groupValues(sorted_perm, values, counts);
+
+    u128 total, block;
+    countPermutations(counts, total);
+    u128 rank = 0;
+    int m = perm.size();
+    for (int t = 0; t < (int)perm.size(); t++, m--) {
+        int k = lower_bound(values.begin(), values.end(), perm[t]) - values.begin();
+        // Todas las permutaciones que ponen un valor menor en la posición t
+        // van antes que 'perm'.
+        for (int v = 0; v < k; v++) {
+            mulDivExact(total, counts[v], m, block);  // block <= total
+            rank += block;
+        }
+        mulDivExact(total, counts[k], m, total);
+        counts[k]--;
+    }
+    return rank;
+}
+
+// Inversa de rankPermutation: la permutación en la posición 'rank' del
+// multiconjunto 'sorted_nums' (ordenado). Requiere rank < countPermutations
+// (y que éste quepa en 128 bits).
+vector<int> unrankPermutation(const vector<int>& sorted_nums, u128 rank) {
+    vector<int> values, counts;
+    groupValues(sorted_nums, values, counts);
+
+    u128 total;
+    countPermutations(counts, total);
+    vector<int> perm;
+    perm.reserve(sorted_nums.size());
+    for (int m = sorted_nums.size(); m > 0; m--) {
+        for (int v = 0; v < (int)values.size(); v++) {
+            if (counts[v] == 0) continue;
+            u128 block;
+            mulDivExact(total, counts[v], m, block);  // block <= total
+            if (rank < block) {
+                perm.push_back(values[v]);
+                total = block;
+                counts[v]--;
+                break;
+            }
+            rank -= block;
+        }
+    }
+    return perm;
+}
+
+// Genera 'limit' permutaciones únicas consecutivas (o hasta la última) a
+// partir de 'p', y las escribe en 'out' con el mismo formato que
+// generatePermutations(). Para enumerar todas, 'p' debe ser el arreglo ordenado.
+// 'flush' se llama cada vez que el búfer supera 'flush_size' bytes (y al final).
+template <typename Flush>
+void generatePermutationsIterative(vector<int> p, string& out, Flush flush,
+                                   size_t flush_size = 1 << 16,
+                                   u128 limit = ~(u128)0) {
+    int n = p.size();
+    if (limit == 0) return;
+    if (n == 0) {
+        // La única permutación de un conjunto vacío: una línea vacía, igual
+        // que generatePermutations().
+        out += '\n';
+        flush(out);
+        out.clear();
+        return;
+    }
+
+    // Texto precalculado de cada valor, para no convertir números en cada línea.
+    // Permutamos 'id' (el índice de cada valor entre los valores distintos) en
+    // lugar de los valores: el orden es el mismo y el texto es un acceso directo.
+    vector<int> values = p;
+    sort(values.begin(), values.end());
+    values.erase(unique(values.begin(), values.end()), values.end());
+    vector<string> text_of(values.size());
+    for (size_t k = 0; k < values.size(); k++) text_of[k] = to_string(values[k]);
+
+    vector<int> id(n);
+    for (int t = 0; t < n; t++) {
+        id[t] = (int)(lower_bound(values.begin(), values.end(), p[t]) - values.begin());
+    }
+
+    // 'line' es la línea actual; offset[t] es dónde empieza el número t en ella.
+    string line;
+    vector<size_t> offset(n);
+    auto formatFrom = [&](int from) {
+        line.resize(offset[from]);
+        for (int t = from; t < n; t++) {
+            offset[t] = line.size();
+            line += text_of[id[t]];
+            line += (t == n - 1 ? '\n' : ' ');
+        }
+    };
+
+    formatFrom(0);
+    while (true) {
+        out += line;
+        if (out.size() >= flush_size) {
+            flush(out);
+            out.clear();
+        }
+
+        if (--limit == 0) break;
+        int changed = nextMultisetPermutation(id);
+        if (changed < 0) break;
+
+        // Sólo el sufijo desde 'changed' es distinto: reescribimos desde ahí.
+        formatFrom(changed);
+    }
+    if (!out.empty()) {
+        flush(out);
+        out.clear();
+    }
+}
+
+// Genera las permutaciones con rank en [from, to) repartiendo el rango entre
+// 'threads' hilos. Cada hilo escribe en su propio búfer y luego los
+// escribimos en orden, así que la salida es idéntica a la secuencial.
+void generatePermutationsParallel(const vector<int>& sorted_nums, u128 from, u128 to,
+                                  int threads, ostream& os) {
+    if (from >= to) return;
+    if (threads < 1) threads = 1;
+    if ((u128)threads > to - from) threads = (int)(to - from);
+
+    vector<string> shards(threads);
+    vector<thread> workers;
+    u128 span = to - from;
+    for (int w = 0; w < threads; w++) {
+        u128 begin = from + span * w / threads;
+        u128 end = from + span * (w + 1) / threads;
+        workers.emplace_back([&, w, begin, end]() {
+            string out;
+            generatePermutationsIterative(unrankPermutation(sorted_nums, begin), out,
+                [&](string& chunk) { shards[w].append(chunk); },
+                1 << 16, end - begin);
+        });
+    }
+    for (int w = 0; w < threads; w++) {
+        workers[w].join();
+        os.write(shards[w].data(), shards[w].size());
+        string().swap(shards[w]);  // Liberamos memoria apenas se escribe
+    }
+}
+
+// cout no sabe imprimir __int128, así que lo convertimos a texto a mano.
+string toString(u128 x) {
+    if (x == 0) return "0";
+    string digits;
+    while (x > 0) {
+        digits += (char)('0' + (int)(x % 10));
+        x /= 10;
+    }
+    reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+#ifdef BENCHMARK
 int main() {
+    // N = 12 con muchos duplicados: 12! / (3!)^4 = 369600 permutaciones únicas.
+    vector<int> base = {1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4};
+    const int ROUNDS = 10;
+
+    N = base.size();
+    nums = base;
+    sort(nums.begin(), nums.end());
+
+    // Redirigimos cout a un búfer en memoria para medir sólo la generación.
+    size_t recursive_bytes = 0;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        ostringstream sink;
+        streambuf* old = cout.rdbuf(sink.rdbuf());
+        visited.assign(N, false);
+        current_perm.clear();
+        generatePermutations();
+        cout.rdbuf(old);
+        recursive_bytes += sink.str().size();
+    }
+    double recursive_secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t iterative_bytes = 0;
+    string out;
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        generatePermutationsIterative(nums, out, [&](string& chunk) {
+            iterative_bytes += chunk.size();
+        });
+    }
+    double iterative_secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Recursiva: " << recursive_secs << " s (" << recursive_bytes << " bytes)\n";
+    cout << "Iterativa: " << iterative_secs << " s (" << iterative_bytes << " bytes)\n";
+
+    int threads = max(1u, thread::hardware_concurrency());
+    size_t parallel_bytes = 0;
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        ostringstream sink;
+        u128 total;
+        countPermutations({3, 3, 3, 3}, total);
+        generatePermutationsParallel(nums, 0, total, threads, sink);
+        parallel_bytes += sink.str().size();
+    }
+    double parallel_secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Paralela (" << threads << " hilos): " << parallel_secs << " s ("
+         << parallel_bytes << " bytes)\n";
+    return 0;
+}
+#else
+int main(int argc, char* argv[]) {
+    // Lectura de los modos opcionales
+    bool count_only = false;
+    int threads = 1;
+    bool has_range = false;
+    unsigned long long range_from = 0, range_to = 0;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--count") == 0) {
+            count_only = true;
+        } else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            threads = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--range") == 0 && a + 2 < argc) {
+            has_range = true;
+            range_from = strtoull(argv[++a], NULL, 10);
+            range_to = strtoull(argv[++a], NULL, 10);
+        }
+    }
+
     // Optimización de I/O
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
@@ -116,8 +526,46 @@ int main() {
     // Paso 1: Ordenar para agrupar duplicados y asegurar orden lexicográfico
     sort(nums.begin(), nums.end());
 
-    // Paso 2: Iniciar Backtracking
-    generatePermutations();
+    vector<int> values, counts;
+    groupValues(nums, values, counts);
+    u128 total;
+    bool fits = countPermutations(counts, total);
+
+    // Modo conteo: el multinomial, sin enumerar nada.
+    if (count_only) {
+        cout << (fits ? toString(total) : countPermutationsBig(counts).toString()) << "\n";
+        return 0;
+    }
+
+    if (!fits) {
+        // Los ranks no caben en 128 bits: no podemos cortar ni repartir.
+        if (has_range || threads > 1) {
+            cerr << "Error: hay más de 2^128 permutaciones; --range y --threads no "
+                    "están disponibles para esta entrada\n";
+            return 1;
+        }
+        total = ~(u128)0;  // Sin límite: la generación para en la última
+    }
+
+    u128 from = 0, to = total;
+    if (has_range) {
+        from = min((u128)range_from, total);
+        to = min((u128)range_to, total);
+    }
+
+    if (threads > 1) {
+        generatePermutationsParallel(nums, from, to, threads, cout);
+        return 0;
+    }
+
+    // Paso 2: Generar iterativamente, volcando el búfer con una sola escritura
+    // por bloque. (generatePermutations() produce exactamente la misma salida.)
+    if (from >= to) return 0;
+    string out;
+    generatePermutationsIterative(unrankPermutation(nums, from), out, [](string& chunk) {
+        cout.write(chunk.data(), chunk.size());
+    }, 1 << 16, to - from);
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
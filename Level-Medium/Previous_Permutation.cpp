@@ -28,6 +28,20 @@
  * Después del intercambio, la parte derecha quedó en orden ascendente (el "menor" orden posible).
  * Para que sea la permutación INMEDIATAMENTE ANTERIOR, necesitamos que esa parte
  * esté en su configuración "máxima" (orden descendente). Por eso invertimos el sufijo.
+ *
+ * SALTAR K PERMUTACIONES HACIA ATRÁS (O(N log N)):
+ * Para retroceder K pasos (K hasta 10^18) no podemos llamar K veces a la
+ * función anterior. En su lugar usamos la "base factorial" (código de Lehmer):
+ * - El dígito de la posición i es cuántos valores AÚN NO USADOS son menores
+ *   que p[i]. Ese dígito vale entre 0 y N-1-i, y el rank de la permutación es
+ *   d[0] * (N-1)! + d[1] * (N-2)! + ... + d[N-1] * 0!.
+ * - Los conteos de "no usados menores que x" se obtienen con un árbol de
+ *   Fenwick sobre los valores (1 = disponible), en O(log N) cada uno.
+ * - Restar K es una resta con préstamo (borrow) en base mixta: la posición i
+ *   tiene base N-i. Si al final queda préstamo, no existe tal permutación.
+ * - Para reconstruir, buscamos en el Fenwick el (d[i]+1)-ésimo valor
+ *   disponible con un descenso binario, también en O(log N).
+ * Esta versión supone valores distintos (una permutación en sentido estricto).
  */
 
 #include <iostream>
@@ -80,6 +94,109 @@ bool previousPermutation(vector<int>& p) {
     return true;
 }
 
+// Árbol de Fenwick de conteos sobre las posiciones 1..n.
+struct CountFenwick {
+    int n, top;
+    vector<int> tree;
+
+    void reset(int size) {
+        n = size;
+        tree.assign(n + 1, 0);
+        // Construcción O(N) con todas las posiciones en 1.
+        for (int i = 1; i <= n; i++) {
+            tree[i] += 1;
+            int parent = i + (i & -i);
+            if (parent <= n) tree[parent] += tree[i];
+        }
+        top = 1;
+        while (top * 2 <= n) top *= 2;
+    }
+
+    void add(int i, int delta) {
+        for (; i <= n; i += i & -i) tree[i] += delta;
+    }
+
+    // Cantidad de posiciones disponibles en [1, i].
+    int prefix(int i) const {
+        int sum = 0;
+        for (; i > 0; i -= i & -i) sum += tree[i];
+        return sum;
+    }
+
+    // Menor posición cuyo prefijo llega a 'k' (k >= 1): descenso binario.
+    int findKth(int k) const {
+        int pos = 0;
+        for (int step = top; step > 0; step >>= 1) {
+            if (pos + step <= n && tree[pos + step] < k) {
+                pos += step;
+                k -= tree[pos];
+            }
+        }
+        return pos + 1;
+    }
+};
+
+// Retrocede 'k' permutaciones en orden lexicográfico modificando 'p'.
+// Retorna false (sin modificar 'p') si hay menos de 'k' permutaciones antes.
+// 'fw', 'sorted_vals' y 'digits' son espacio de trabajo reutilizable entre llamadas.
+bool jumpBackward(vector<int>& p, unsigned long long k, CountFenwick& fw,
+                  vector<int>& sorted_vals, vector<int>& digits) {
+    int n = p.size();
+    if (k == 0) return true;
+
+    // Comprimimos los valores a 1..n para indexar el Fenwick.
+    sorted_vals.assign(p.begin(), p.end());
+    sort(sorted_vals.begin(), sorted_vals.end());
+
+    // PASO 1: Código de Lehmer de 'p'.
+    fw.reset(n);
+    digits.resize(n);
+    for (int i = 0; i < n; i++) {
+        int v = lower_bound(sorted_vals.begin(), sorted_vals.end(), p[i]) - sorted_vals.begin() + 1;
+        digits[i] = fw.prefix(v - 1);
+        fw.add(v, -1);
+    }
+
+    // PASO 2: Restar k en base factorial, desde el dígito menos significativo
+    // (posición n-1, base 1) hacia el más significativo (posición 0, base n).
+    long long borrow = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        long long base = n - i;
+        long long d = digits[i] - borrow - (long long)(k % base);
+        k /= base;
+        borrow = 0;
+        if (d < 0) {
+            d += base;
+            borrow = 1;
+        }
+        digits[i] = (int)d;
+    }
+    // Si sobra k o préstamo, el resultado sería negativo: no existe.
+    if (k > 0 || borrow) return false;
+
+    // PASO 3: Reconstruir la permutación desde los dígitos.
+    fw.reset(n);
+    for (int i = 0; i < n; i++) {
+        int v = fw.findKth(digits[i] + 1);
+        fw.add(v, -1);
+        p[i] = sorted_vals[v - 1];
+    }
+    return true;
+}
+
+// Versión por lotes: aplica jumpBackward a cada par (perms[q], ks[q]),
+// reutilizando el mismo espacio de trabajo. ok[q] indica si existió.
+vector<bool> jumpBackwardBatch(vector<vector<int>>& perms,
+                               const vector<unsigned long long>& ks) {
+    CountFenwick fw;
+    vector<int> sorted_vals, digits;
+    vector<bool> ok(perms.size());
+    for (size_t q = 0; q < perms.size(); q++) {
+        ok[q] = jumpBackward(perms[q], ks[q], fw, sorted_vals, digits);
+    }
+    return ok;
+}
+
 int main() {
     // Optimización de I/O
     ios_base::sync_with_stdio(false);